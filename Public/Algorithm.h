@@ -4,6 +4,8 @@
 #pragma once
 #include "common.h"
 #include "AlgorithmRunner.h"
+#include "Parallel.h"
+#include "Routing\AlgorithmChangeVersion.h"
 
 namespace NiT
 {
@@ -42,6 +44,56 @@ namespace NiT
             return TryRun(*container);
         }
 
+        /// <summary>
+        /// Will execute the algorithm on the container as part of a run over multiple containers, see BeginRun.
+        /// Columns the algorithm writes are stamped with runVersion.
+        /// </summary>
+        template<typename TContainer>
+        bool TryRun(TContainer& container, const uint32 runVersion)const
+        {
+            return AlgorithmRunner<Algorithm_t, TContainer>::TryRun(*Impl(), container, runVersion);
+        }
+
+        /// <summary>
+        /// Start a run over multiple containers and get its version to pass to each TryRun.
+        /// Once all containers ran, CommitRun makes the algorithm's Changed filters skip the chunks not written since the run started.
+        /// A run must use a single version for all containers: committing after each container would skip the chunks 
+        /// written before that container ran but after the previous run.
+        /// </summary>
+        static uint32 BeginRun() { return ChangeVersion::Increment(); }
+
+        /// <summary>
+        /// Commit a run started with BeginRun once all containers ran with its runVersion.
+        /// Until a run is committed, the algorithm's Changed filters accept every chunk written since the last committed run,
+        /// or every chunk if none was.
+        /// </summary>
+        void CommitRun(const uint32 runVersion)const
+        {
+            Routing::CommitAlgorithmChange::Commit(*Impl(), runVersion);
+        }
+
+        /// <summary>
+        /// Will execute the algorithm on the container from multiple threads if all requirements are fulfilled and return true.
+        /// Chunk elements of arrays are split in ranges, each range running on its own copy of the algorithm.
+        /// </summary>
+        /// <param name="policy">Number of threads and elements per range.</param>
+        /// <param name="container">The container to execute the algorithm on.</param>
+        /// <returns>If it successfully executed the algorithm on the container.</returns>
+        template<typename TContainer>
+        bool TryRun(const ParallelPolicy& policy, TContainer& container)const
+        {
+            return AlgorithmRunner<Algorithm_t, TContainer>::TryRun(policy, *Impl(), container);
+        }
+
+        /// <summary>
+        /// Will execute the algorithm on the container from multiple threads as part of a run over multiple containers, see BeginRun.
+        /// </summary>
+        template<typename TContainer>
+        bool TryRun(const ParallelPolicy& policy, TContainer& container, const uint32 runVersion)const
+        {
+            return AlgorithmRunner<Algorithm_t, TContainer>::TryRun(policy, *Impl(), container, runVersion);
+        }
+
         /// <summary>
         /// Route using a router and execute an algorithm on a chunk if all requirements are fulfilled and return true.
         /// </summary>
@@ -56,6 +108,15 @@ namespace NiT
             return AlgorithmRunner<Algorithm_t, TContainer>::TryRun(router, *Impl(), container);
         }
 
+        /// <summary>
+        /// Route using a router and execute an algorithm on a chunk as part of a run over multiple containers, see BeginRun.
+        /// </summary>
+        template<typename TRouter, typename TContainer>
+        bool TryRun(const TRouter& router, TContainer& container, const uint32 runVersion)const
+        {
+            return AlgorithmRunner<Algorithm_t, TContainer>::TryRun(router, *Impl(), container, runVersion);
+        }
+
         /// <summary>
         /// Will execute the algorithm on a matching chunk.
         /// The chunk must not be null and must match the algorithm or it halt execution
@@ -84,6 +145,19 @@ namespace NiT
         }
 
 
+        /// <summary>
+        /// Will execute the algorithm on a matching container from multiple threads.
+        /// The container must not be null and must match the algorithm or it halt execution
+        /// </summary>
+        template<typename TContainer>
+        void Run(const ParallelPolicy& policy, TContainer& container)const
+        {
+            if (!TryRun(policy, container))
+            {
+                ni_assertf(false, TEXT("Could not run algorithm '%hs' on chunk '%hs'. The chunk failed the algorithm requirements."), typeid(Algorithm_t).name(), typeid(TContainer).name());
+            }
+        }
+
         /// <summary>
         /// Route using a router and execute an algorithm on a chunk
         /// The chunk must not be null and must match the algorithm or it halt execution
@@ -18,6 +18,8 @@ namespace NiT
 
         /// <summary>
         /// Get access to a specific component in the current chunk.
+        /// Request a const TComponent* to declare the algorithm only reads the component,
+        /// letting a ParallelPipelineT run it concurrently with other readers.
         /// </summary>
         /// <typeparam name="T"></typeparam>
         /// <param name="component"></param>
@@ -28,6 +30,21 @@ namespace NiT
             return false;
         }
 
+        /// <summary>
+        /// Filter the chunks an algorithm executes on to those where a component was written since the algorithm's last run.
+        /// lastRunVersion is a ChangeVersion field of the algorithm, set by Algorithm::CommitRun once a run over all containers is done.
+        /// Unlike other requirements, filters are ignored and succeed by default.
+        /// </summary>
+        /// <typeparam name="TComponent"></typeparam>
+        /// <param name="component">Component pointer the algorithm also requires with Component.</param>
+        /// <param name="lastRunVersion"></param>
+        /// <returns></returns>
+        template<typename TComponent>
+        bool Changed(TComponent*& component, uint32& lastRunVersion)
+        {
+            return true;
+        }
+
         /// <summary>
         /// Get access to a specific component in the parent chunk.
         /// </summary>
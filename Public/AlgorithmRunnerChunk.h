@@ -6,24 +6,93 @@
 #include "DChunkPointer.h"
 #include "Routing\SetAlgorithmChunk.h"
 #include "Routing\OffsetAlgorithmNode.h"
+#include "Routing\OffsetAlgorithmNodeSlice.h"
+#include "Routing\AlgorithmChangeVersion.h"
+#include "Parallel.h"
 
 namespace NiT
 {
     template<typename TContainer>
     struct AlgorithmRunnerChunk
     {
+        using Chunk_t = std::remove_reference_t<decltype(std::declval<TContainer&>().GetChunk())>;
+
         /// <summary>
-        /// Route and execute an algorithm on a chunk
+        /// Route and execute an algorithm on a chunk.
+        /// The execution is skipped if the algorithm's Changed filters reject the chunk, which still succeeds.
+        /// The Changed filters are not committed, see Algorithm::CommitRun.
         /// </summary>
         template<typename TAlgorithm>
         static bool TryRun(TAlgorithm& algorithm, TContainer& container)
+        {
+            return TryRun(algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on a chunk as part of a run over multiple containers,
+        /// stamping the columns it writes with the run's version taken once for all containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TAlgorithm>
+        static bool TryRun(TAlgorithm& algorithm, TContainer& container, const uint32 runVersion)
+        {
+            if (container.IsNull())
+                return false;
+            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<TContainer>(&container)))
+                return false;
+            if (Routing::FilterAlgorithmChange<Chunk_t>::ShouldExecute(algorithm, container.GetChunk()))
+            {
+                Routing::StampAlgorithmChange<Chunk_t>::Stamp(algorithm, container.GetChunk(), runVersion);
+                const auto nodeCount = container.GetNodeCount();
+                algorithm.Execute(nodeCount);
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on a chunk from multiple threads.
+        /// </summary>
+        template<typename TAlgorithm>
+        static bool TryRun(const ParallelPolicy& policy, TAlgorithm& algorithm, TContainer& container)
+        {
+            return TryRun(policy, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on a chunk from multiple threads as part of a run over multiple containers.
+        /// The chunk's nodes are split in slices of policy.Grain nodes, or NI_PARALLEL_SLICE_BYTES of node component data
+        /// when no Grain is set. Each slice runs on its own copy of the algorithm with its NodeComponent pointers offset to the 
+        /// slice's first node. ChunkComponents are shared by all slices and must only be read.
+        /// </summary>
+        template<typename TAlgorithm>
+        static bool TryRun(const ParallelPolicy& policy, TAlgorithm& algorithm, TContainer& container, const uint32 runVersion)
         {
             if (container.IsNull())
                 return false;
             if (!algorithm.Requirements(Routing::SetAlgorithmChunk<TContainer>(&container)))
                 return false;
-            const auto nodeCount = container.GetNodeCount();
-            algorithm.Execute(nodeCount);
+            using Size_t = typename TContainer::Size_t;
+            if (!Routing::FilterAlgorithmChange<Chunk_t>::ShouldExecute(algorithm, container.GetChunk()))
+                return true;
+            Routing::StampAlgorithmChange<Chunk_t>::Stamp(algorithm, container.GetChunk(), runVersion);
+            const Size_t nodeCount = container.GetNodeCount();
+            ParallelPolicy slicePolicy(policy);
+            if (slicePolicy.Grain == 0)
+            {
+                const std::size_t bytesPerNode = std::max<std::size_t>(1, container.GetStructure().BlockNodeSize);
+                slicePolicy.Grain = std::max<std::size_t>(1, NI_PARALLEL_SLICE_BYTES / bytesPerNode);
+            }
+            if ((std::size_t)nodeCount <= slicePolicy.Grain)
+            {
+                algorithm.Execute(container.GetNodeCount());
+                return true;
+            }
+            ParallelFor(slicePolicy, nodeCount, [&algorithm](const Size_t firstNode, const Size_t sliceNodeCount)
+            {
+                TAlgorithm sliceAlgorithm(algorithm);
+                sliceAlgorithm.Requirements(Routing::OffsetAlgorithmNodeSlice<TContainer>(firstNode));
+                sliceAlgorithm.Execute(PropNodeCountT<Size_t>(sliceNodeCount));
+            });
             return true;
         }
 
@@ -32,12 +101,27 @@ namespace NiT
         /// </summary>
         template<typename TRouter, typename TAlgorithm>
         static bool TryRun(const TRouter& router, TAlgorithm& algorithm, TContainer& container)
+        {
+            return TryRun(router, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route using a router and execute an algorithm on a chunk as part of a run over multiple containers,
+        /// stamping the columns it writes with the run's version taken once for all containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TRouter, typename TAlgorithm>
+        static bool TryRun(const TRouter& router, TAlgorithm& algorithm, TContainer& container, const uint32 runVersion)
         {
             ni_assert(!container.IsNull());
             if (!router.RouteAlgorithm(algorithm, container))
                 return false;
-            const auto nodeCount = container.GetNodeCount();
-            algorithm.Execute(nodeCount);
+            if (Routing::FilterAlgorithmChange<Chunk_t>::ShouldExecute(algorithm, container.GetChunk()))
+            {
+                Routing::StampAlgorithmChange<Chunk_t>::Stamp(algorithm, container.GetChunk(), runVersion);
+                const auto nodeCount = container.GetNodeCount();
+                algorithm.Execute(nodeCount);
+            }
             return true;
         }
     };
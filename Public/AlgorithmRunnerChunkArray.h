@@ -5,6 +5,9 @@
 #include "common.h"
 #include "Routing\SetAlgorithmChunk.h"
 #include "Routing\OffsetAlgorithmNode.h"
+#include "Routing\SetAlgorithmChunkElement.h"
+#include "Routing\AlgorithmChangeVersion.h"
+#include "Parallel.h"
 
 namespace NiT
 {
@@ -19,15 +22,28 @@ namespace NiT
         using Container_t = TContainer;
         using ChunkStructure_t = typename TContainer::ChunkStructure_t;
         using Size_t = typename TContainer::Size_t;
+        using ChunkElement_t = std::remove_reference_t<decltype(std::declval<TContainer&>()[0])>;
 
     public:
         /// <summary>
         /// Route and execute an algorithm on all element Chunks in the array.
+        /// Elements rejected by the algorithm's Changed filters are skipped.
+        /// The Changed filters are not committed, see Algorithm::CommitRun.
         /// </summary>
         /// <param name="algorithm"></param>
         /// <param name="chunkPtr"></param>
         /// <returns></returns>
         static bool TryRun(Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on all element Chunks in the array as part of a run over multiple containers,
+        /// stamping the columns it writes with the run's version taken once for all containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        static bool TryRun(Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
         {
             if (container.IsNull())
                 return false;
@@ -37,13 +53,55 @@ namespace NiT
             {
                 auto& chunkElement = container[i];
                 auto elementNodeCount = chunkElement.GetNodeCount();
-                algorithm.Execute(elementNodeCount);
+                ExecuteIfChanged(algorithm, chunkElement, runVersion);
                 if (!algorithm.Requirements(Routing::OffsetAlgorithmNode<Container_t>(elementNodeCount)))
                     return false;
             }
             return true;
         }
 
+        /// <summary>
+        /// Route and execute an algorithm on all element Chunks in the array from multiple threads.
+        /// </summary>
+        static bool TryRun(const ParallelPolicy& policy, Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(policy, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on all element Chunks in the array from multiple threads as part of a run over multiple containers.
+        /// The elements are split in ranges claimed by the policy's threads. Each range runs on its own copy of the 
+        /// algorithm routed to the range's first element directly, then offset to the following elements like TryRun does.
+        /// </summary>
+        static bool TryRun(const ParallelPolicy& policy, Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
+        {
+            if (container.IsNull())
+                return false;
+            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<Container_t>(&container)))
+                return false;
+            std::atomic<bool> ok(true);
+            ParallelFor(policy, (Size_t)container.GetChunkCount(), [&algorithm, &container, &ok, runVersion](const Size_t firstElement, const Size_t elementCount)
+            {
+                Algorithm_t rangeAlgorithm(algorithm);
+                if (!rangeAlgorithm.Requirements(Routing::SetAlgorithmChunkElement<Container_t>(&container, firstElement)))
+                {
+                    ok = false;
+                    return;
+                }
+                for (Size_t i = firstElement; i < firstElement + elementCount; ++i)
+                {
+                    auto elementNodeCount = container[i].GetNodeCount();
+                    ExecuteIfChanged(rangeAlgorithm, container[i], runVersion);
+                    if (!rangeAlgorithm.Requirements(Routing::OffsetAlgorithmNode<Container_t>(elementNodeCount)))
+                    {
+                        ok = false;
+                        return;
+                    }
+                }
+            });
+            return ok;
+        }
+
         /// <summary>
         /// Route using a given router and execute an algorithm on each element Chunks in the array.
         /// </summary>
@@ -54,6 +112,17 @@ namespace NiT
         /// <returns></returns>
         template<typename TRouter>
         static bool TryRun(const TRouter& router, Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(router, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route using a given router and execute an algorithm on each element Chunks in the array as part of a run over
+        /// multiple containers, stamping the columns it writes with the run's version taken once for all containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TRouter>
+        static bool TryRun(const TRouter& router, Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
         {
             ni_assert(!container.IsNull());
             if (!router.RouteAlgorithm(algorithm, container))
@@ -63,11 +132,24 @@ namespace NiT
             {
                 auto& chunkElement = container[i];
                 auto elementNnodeCount = chunkElement.GetNodeCount();
-                algorithm.Execute(elementNnodeCount);
+                ExecuteIfChanged(algorithm, chunkElement, runVersion);
                 bool nextOk = algorithm.Requirements(Routing::OffsetAlgorithmNode<Container_t>(elementNnodeCount));
                 ni_assert(nextOk);
             }
             return true;
         }
+
+    protected:
+        /// <summary>
+        /// Execute an algorithm already routed to a chunk element if its Changed filters accept the element
+        /// and stamp the element's written columns with runVersion.
+        /// </summary>
+        static void ExecuteIfChanged(Algorithm_t& algorithm, ChunkElement_t& chunkElement, const uint32 runVersion)
+        {
+            if (!Routing::FilterAlgorithmChange<ChunkElement_t>::ShouldExecute(algorithm, chunkElement))
+                return;
+            Routing::StampAlgorithmChange<ChunkElement_t>::Stamp(algorithm, chunkElement, runVersion);
+            algorithm.Execute(chunkElement.GetNodeCount());
+        }
     };
 }
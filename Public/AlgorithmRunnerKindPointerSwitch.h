@@ -41,17 +41,53 @@ namespace NiT
         /// <param name="container"></param>
         /// <returns></returns>
         static bool TryRun(Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on a chunk as part of a run over multiple containers,
+        /// stamping the columns it writes with the run's version taken once for all containers.
+        /// </summary>
+        static bool TryRun(Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
         {
             switch (container.GetKind())
             {
             case ContainerKind::Chunk:
-                return AlgorithmRunnerChunk<KChunkPointer_t>::TryRun(algorithm, (KChunkPointer_t&)container);
+                return AlgorithmRunnerChunk<KChunkPointer_t>::TryRun(algorithm, (KChunkPointer_t&)container, runVersion);
             case ContainerKind::Array:
-                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayPointer_t>::TryRun(algorithm, (KChunkArrayPointer_t&)container);
+                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayPointer_t>::TryRun(algorithm, (KChunkArrayPointer_t&)container, runVersion);
             case ContainerKind::ChunkTree:
-                return AlgorithmRunnerChunk<KChunkTreePointer_t>::TryRun(algorithm, (KChunkTreePointer_t&)container);
+                return AlgorithmRunnerChunk<KChunkTreePointer_t>::TryRun(algorithm, (KChunkTreePointer_t&)container, runVersion);
             case ContainerKind::ArrayTree:
-                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayTreePointer_t>::TryRun(algorithm, (KChunkArrayTreePointer_t&)container);
+                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayTreePointer_t>::TryRun(algorithm, (KChunkArrayTreePointer_t&)container, runVersion);
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on a chunk with an execution policy.
+        /// </summary>
+        static bool TryRun(const ParallelPolicy& policy, Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(policy, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on a chunk with an execution policy as part of a run over multiple containers.
+        /// </summary>
+        static bool TryRun(const ParallelPolicy& policy, Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
+        {
+            switch (container.GetKind())
+            {
+            case ContainerKind::Chunk:
+                return AlgorithmRunnerChunk<KChunkPointer_t>::TryRun(policy, algorithm, (KChunkPointer_t&)container, runVersion);
+            case ContainerKind::Array:
+                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayPointer_t>::TryRun(policy, algorithm, (KChunkArrayPointer_t&)container, runVersion);
+            case ContainerKind::ChunkTree:
+                return AlgorithmRunnerChunk<KChunkTreePointer_t>::TryRun(policy, algorithm, (KChunkTreePointer_t&)container, runVersion);
+            case ContainerKind::ArrayTree:
+                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayTreePointer_t>::TryRun(policy, algorithm, (KChunkArrayTreePointer_t&)container, runVersion);
             }
             return true;
         }
@@ -66,17 +102,27 @@ namespace NiT
         /// <returns></returns>
         template<typename TRouter>
         static bool TryRun(const TRouter& router, Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(router, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route using a router and execute an algorithm on a chunk as part of a run over multiple containers,
+        /// stamping the columns it writes with the run's version taken once for all containers.
+        /// </summary>
+        template<typename TRouter>
+        static bool TryRun(const TRouter& router, Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
         {
             switch (container.GetKind())
             {
             case ContainerKind::Chunk:
-                return AlgorithmRunnerChunk<KChunkPointer_t>::TryRun(router, algorithm, (KChunkPointer_t&)container);
+                return AlgorithmRunnerChunk<KChunkPointer_t>::TryRun(router, algorithm, (KChunkPointer_t&)container, runVersion);
             case ContainerKind::Array:
-                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayPointer_t>::TryRun(router, algorithm, (KChunkArrayPointer_t&)container);
+                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayPointer_t>::TryRun(router, algorithm, (KChunkArrayPointer_t&)container, runVersion);
             case ContainerKind::ChunkTree:
-                return AlgorithmRunnerChunk<KChunkTreePointer_t>::TryRun(router, algorithm, (KChunkTreePointer_t&)container);
+                return AlgorithmRunnerChunk<KChunkTreePointer_t>::TryRun(router, algorithm, (KChunkTreePointer_t&)container, runVersion);
             case ContainerKind::ArrayTree:
-                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayTreePointer_t>::TryRun(router, algorithm, (KChunkArrayTreePointer_t&)container);
+                return AlgorithmRunnerChunkArray<Algorithm_t, KChunkArrayTreePointer_t>::TryRun(router, algorithm, (KChunkArrayTreePointer_t&)container, runVersion);
             }
             return true;
         }
@@ -0,0 +1,124 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRunner.h"
+#include "Routing\AlgorithmMatchStructure.h"
+#include "Routing\AlgorithmChangeVersion.h"
+#include "Parallel.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Execute an algorithm on each page of a Paged container.
+    /// Pages are separate allocations, so the algorithm is routed to each page on its own copy
+    /// instead of being offset from one page to the next like AlgorithmRunnerChunkArray does.
+    /// </summary>
+    template<typename TAlgorithm, typename TContainer>
+    struct AlgorithmRunnerPaged
+    {
+    public:
+        using Algorithm_t = TAlgorithm;
+        using Container_t = TContainer;
+        using ChunkStructure_t = typename TContainer::ChunkStructure_t;
+        using Size_t = typename TContainer::Size_t;
+        using Page_t = typename TContainer::Page_t;
+
+    public:
+        /// <summary>
+        /// Route and execute an algorithm on all pages.
+        /// A container without pages succeeds if its structure fulfills the algorithm's component requirements.
+        /// The Changed filters are not committed, see Algorithm::CommitRun.
+        /// </summary>
+        static bool TryRun(Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on all pages as part of a run over multiple containers,
+        /// stamping the columns it writes with the run's version taken once for all containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        static bool TryRun(Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
+        {
+            if (container.IsNull())
+                return false;
+            if (container.GetChunkCount() == 0)
+                return IsMatching(algorithm, container);
+            for (Size_t i = 0; i < container.GetChunkCount(); ++i)
+            {
+                Algorithm_t pageAlgorithm(algorithm);
+                if (!AlgorithmRunner<Algorithm_t, Page_t>::TryRun(pageAlgorithm, container[i], runVersion))
+                    return false;
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on all pages from multiple threads.
+        /// </summary>
+        static bool TryRun(const ParallelPolicy& policy, Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(policy, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on all pages from multiple threads as part of a run over multiple containers,
+        /// the pages being distributed across the policy's threads.
+        /// </summary>
+        static bool TryRun(const ParallelPolicy& policy, Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
+        {
+            if (container.IsNull())
+                return false;
+            if (container.GetChunkCount() == 0)
+                return IsMatching(algorithm, container);
+            std::atomic<bool> ok(true);
+            ParallelFor(policy, (Size_t)container.GetChunkCount(), [&algorithm, &container, &ok, runVersion](const Size_t firstPage, const Size_t pageCount)
+            {
+                for (Size_t i = firstPage; i < firstPage + pageCount; ++i)
+                {
+                    Algorithm_t pageAlgorithm(algorithm);
+                    if (!AlgorithmRunner<Algorithm_t, Page_t>::TryRun(pageAlgorithm, container[i], runVersion))
+                        ok = false;
+                }
+            });
+            return ok;
+        }
+
+        /// <summary>
+        /// Route using a given router and execute an algorithm on all pages.
+        /// </summary>
+        template<typename TRouter>
+        static bool TryRun(const TRouter& router, Algorithm_t& algorithm, Container_t& container)
+        {
+            return TryRun(router, algorithm, container, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Route using a given router and execute an algorithm on all pages as part of a run over multiple containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TRouter>
+        static bool TryRun(const TRouter& router, Algorithm_t& algorithm, Container_t& container, const uint32 runVersion)
+        {
+            ni_assert(!container.IsNull());
+            if (container.GetChunkCount() == 0)
+                return IsMatching(algorithm, container);
+            for (Size_t i = 0; i < container.GetChunkCount(); ++i)
+            {
+                Algorithm_t pageAlgorithm(algorithm);
+                if (!AlgorithmRunner<Algorithm_t, Page_t>::TryRun(router, pageAlgorithm, container[i], runVersion))
+                    return false;
+            }
+            return true;
+        }
+
+    protected:
+        static bool IsMatching(Algorithm_t& algorithm, Container_t& container)
+        {
+            return algorithm.Requirements(Routing::AlgorithmMatchStructure<ChunkStructure_t>(&container.GetStructure()));
+        }
+    };
+}
@@ -0,0 +1,235 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRunner.h"
+#include "Parallel.h"
+#include "TreeSnapshot.h"
+#include "Routing\AlgorithmChangeVersion.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Order in which the depth levels of a tree are executed.
+    /// </summary>
+    enum class TreeOrder : uint8
+    {
+        /// <summary>
+        /// Parents before their children, from the root to the leaves.
+        /// </summary>
+        TopDown,
+
+        /// <summary>
+        /// Children before their parent, from the leaves to the root.
+        /// </summary>
+        BottomUp,
+    };
+
+    /// <summary>
+    /// All containers of a tree grouped by depth level, breadth-first from a root container.
+    /// Built once and reused until the tree version of the root's tree changes.
+    /// </summary>
+    /// <typeparam name="TTreePointer">DTreePointer container type of the tree, ex.: KTreePointerT</typeparam>
+    template<typename TTreePointer>
+    struct TreeLevelsT
+    {
+    public:
+        using Self_t = TreeLevelsT<TTreePointer>;
+        using TreePointer_t = TTreePointer;
+        using Size_t = typename TreePointer_t::Size_t;
+
+    protected:
+        /// <summary>
+        /// Containers of all levels, level after level.
+        /// </summary>
+        std_vector<TreePointer_t*> Containers;
+
+        /// <summary>
+        /// Index in Containers of the first container of each level, followed by the total container count.
+        /// </summary>
+        std_vector<Size_t> LevelFirstIndex;
+
+        const TreePointer_t* Root = nullptr;
+        uint32 TreeVersion = 0;
+
+    public:
+        bool IsUpToDate(const TreePointer_t& root)const
+        {
+            return Root == &root && TreeVersion == root.GetTreeVersion();
+        }
+
+        /// <summary>
+        /// Rebuild the levels if the tree was restructured or if the root is different since the last build.
+        /// </summary>
+        void Update(TreePointer_t& root)
+        {
+            if (!IsUpToDate(root))
+                Build(root);
+        }
+
+        void Build(TreePointer_t& root)
+        {
+            TreeVersion = root.GetTreeVersion();
+            Root = &root;
+            Containers.clear();
+            LevelFirstIndex.clear();
+            Containers.push_back(&root);
+            Size_t levelFirstIndex = 0;
+            while (levelFirstIndex < (Size_t)Containers.size())
+            {
+                LevelFirstIndex.push_back(levelFirstIndex);
+                const Size_t levelEndIndex = (Size_t)Containers.size();
+                for (Size_t i = levelFirstIndex; i < levelEndIndex; ++i)
+                {
+                    TreePointer_t* const firstChild = Containers[i]->GetFirstChildChunk();
+                    if (firstChild == nullptr)
+                        continue;
+                    for (TreePointer_t* child = firstChild;;)
+                    {
+                        Containers.push_back(child);
+                        child = child->GetNextSiblingChunk();
+                        if (child == firstChild)
+                            break;
+                    }
+                }
+                levelFirstIndex = levelEndIndex;
+            }
+            LevelFirstIndex.push_back((Size_t)Containers.size());
+        }
+
+        Size_t GetLevelCount()const { return LevelFirstIndex.empty() ? 0 : (Size_t)LevelFirstIndex.size() - 1; }
+        Size_t GetContainerCount()const { return (Size_t)Containers.size(); }
+        Size_t GetLevelContainerCount(const Size_t level)const { return LevelFirstIndex[level + 1] - LevelFirstIndex[level]; }
+        TreePointer_t* const* GetLevelContainers(const Size_t level)const { return Containers.data() + LevelFirstIndex[level]; }
+    };
+
+    /// <summary>
+    /// Execute an algorithm on all containers of a tree, one depth level at a time.
+    /// Containers of the same level are distributed across threads and a level is complete before the next one starts,
+    /// so with TreeOrder::TopDown an algorithm can read its ParentComponent knowing the parent was already processed.
+    /// The level ordering is cached in the runner until the tree is restructured.
+    /// </summary>
+    /// <typeparam name="TTreePointer">DTreePointer container type of the tree, ex.: KTreePointerT</typeparam>
+    template<typename TTreePointer>
+    struct TreeRunnerT
+    {
+    public:
+        using Self_t = TreeRunnerT<TTreePointer>;
+        using TreePointer_t = TTreePointer;
+        using Size_t = typename TreePointer_t::Size_t;
+        using TreeLevels_t = TreeLevelsT<TreePointer_t>;
+        using TreeSnapshot_t = TreeSnapshotT<TreePointer_t>;
+
+    protected:
+        TreeLevels_t Levels;
+        TreeSnapshot_t Snapshot;
+
+    public:
+        const TreeLevels_t& GetLevels()const { return Levels; }
+        const TreeSnapshot_t& GetSnapshot()const { return Snapshot; }
+
+        /// <summary>
+        /// Execute an algorithm on each container of the tree under root, including root, that fulfills the algorithm requirements.
+        /// Each container runs on its own copy of the algorithm.
+        /// Returns true if the algorithm executed on at least one container.
+        /// The Changed filters are not committed, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TAlgorithm>
+        bool TryRun(TAlgorithm& algorithm, TreePointer_t& root, const TreeOrder order = TreeOrder::TopDown, const ParallelPolicy& policy = ParallelPolicy())
+        {
+            return TryRun(algorithm, root, ChangeVersion::Increment(), order, policy);
+        }
+
+        /// <summary>
+        /// Execute an algorithm on each container of the tree under root as part of a run over multiple trees or containers,
+        /// stamping the columns it writes with the run's version taken once for all of them.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TAlgorithm>
+        bool TryRun(TAlgorithm& algorithm, TreePointer_t& root, const uint32 runVersion, const TreeOrder order = TreeOrder::TopDown, const ParallelPolicy& policy = ParallelPolicy())
+        {
+            Levels.Update(root);
+            std::atomic<bool> anyRun(false);
+            const Size_t levelCount = Levels.GetLevelCount();
+            for (Size_t i = 0; i < levelCount; ++i)
+            {
+                const Size_t level = order == TreeOrder::TopDown ? i : levelCount - 1 - i;
+                TreePointer_t* const* const containers = Levels.GetLevelContainers(level);
+                ParallelFor(policy, Levels.GetLevelContainerCount(level), [&algorithm, &anyRun, containers, runVersion](const Size_t firstIndex, const Size_t count)
+                {
+                    bool rangeRun = false;
+                    for (Size_t c = firstIndex; c < firstIndex + count; ++c)
+                    {
+                        TAlgorithm containerAlgorithm(algorithm);
+                        rangeRun |= AlgorithmRunner<TAlgorithm, TreePointer_t>::TryRun(containerAlgorithm, *containers[c], runVersion);
+                    }
+                    if (rangeRun)
+                        anyRun.store(true, std::memory_order_relaxed);
+                });
+            }
+            return anyRun;
+        }
+
+        /// <summary>
+        /// Execute an algorithm on each container of the tree under root, including root, in depth-first pre-order on the calling thread.
+        /// Walks the cached TreeSnapshot and prefetches the component data of the next container while executing the current one,
+        /// and the container after it, so its component data pointers are in cache by the time they are needed.
+        /// Each container runs on its own copy of the algorithm.
+        /// Returns true if the algorithm executed on at least one container.
+        /// The Changed filters are not committed, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TAlgorithm>
+        bool TryRunPreOrder(TAlgorithm& algorithm, TreePointer_t& root)
+        {
+            return TryRunPreOrder(algorithm, root, ChangeVersion::Increment());
+        }
+
+        /// <summary>
+        /// Execute an algorithm on each container of the tree under root in depth-first pre-order as part of a run over multiple trees or containers.
+        /// The caller commits the run once all containers are done, see Algorithm::CommitRun.
+        /// </summary>
+        template<typename TAlgorithm>
+        bool TryRunPreOrder(TAlgorithm& algorithm, TreePointer_t& root, const uint32 runVersion)
+        {
+            Snapshot.Update(root);
+            bool anyRun = false;
+            TreePointer_t* const* const containers = Snapshot.GetContainers();
+            const Size_t count = Snapshot.GetCount();
+            for (Size_t i = 0; i < count; ++i)
+            {
+                if (i + 2 < count)
+                    ni_prefetch(containers[i + 2]);
+                if (i + 1 < count)
+                    PrefetchComponentData(*containers[i + 1]);
+                TAlgorithm containerAlgorithm(algorithm);
+                anyRun |= AlgorithmRunner<TAlgorithm, TreePointer_t>::TryRun(containerAlgorithm, *containers[i], runVersion);
+            }
+            return anyRun;
+        }
+
+        /// <summary>
+        /// Execute an algorithm on each container of the tree under root.
+        /// At least one container must fulfill the algorithm requirements or it halt execution.
+        /// </summary>
+        template<typename TAlgorithm>
+        void Run(TAlgorithm& algorithm, TreePointer_t& root, const TreeOrder order = TreeOrder::TopDown, const ParallelPolicy& policy = ParallelPolicy())
+        {
+            if (!TryRun(algorithm, root, order, policy))
+            {
+                ni_assertf(false, TEXT("Could not run algorithm '%hs' on tree '%hs'. No container fulfilled the algorithm requirements."), typeid(TAlgorithm).name(), typeid(TreePointer_t).name());
+            }
+        }
+
+    protected:
+        /// <summary>
+        /// Prefetch the start of every component column of a container.
+        /// </summary>
+        static void PrefetchComponentData(const TreePointer_t& container)
+        {
+            const Size_t componentCount = container.GetStructure().GetComponentCount();
+            for (Size_t c = 0; c < componentCount; ++c)
+                ni_prefetch(container.GetComponentData(c));
+        }
+    };
+}
@@ -0,0 +1,216 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Memory allocator recycling blocks of power-of-two size classes.
+    /// Chunks' component data mostly come in a few recurring sizes, freed blocks are kept and reused
+    /// for the next allocation of the same size class instead of going back to FMemory.
+    /// Each thread keeps a cache of free blocks per size class and exchanges them in batches with a global pool.
+    /// Notes:
+    ///     Deallocate must be called with the same size and alignment used to Allocate.
+    ///     Allocations larger than MaxBlockSize or aligned over MaxBlockAlignment go straight to FMemory.
+    ///     Memory of recycled blocks is never returned to FMemory.
+    /// </summary>
+    struct ChunkAllocator
+    {
+    public:
+        static constexpr std::size_t MinBlockSizeLog2 = 4;
+        static constexpr std::size_t MaxBlockSizeLog2 = 20;
+        static constexpr std::size_t MinBlockSize = std::size_t(1) << MinBlockSizeLog2;
+        static constexpr std::size_t MaxBlockSize = std::size_t(1) << MaxBlockSizeLog2;
+        static constexpr std::size_t MaxBlockAlignment = 4096;
+        static constexpr std::size_t SizeClassCount = MaxBlockSizeLog2 - MinBlockSizeLog2 + 1;
+
+        /// <summary>
+        /// Bytes of free blocks moved at once between a thread cache and the global pool.
+        /// </summary>
+        static constexpr std::size_t BatchBytes = 64 * 1024;
+
+        /// <summary>
+        /// Bytes of free blocks a thread cache keeps per size class before returning a batch to the global pool.
+        /// </summary>
+        static constexpr std::size_t ThreadCacheBytes = 4 * BatchBytes;
+
+        /// <summary>
+        /// Minimum bytes allocated from FMemory when the global pool runs out of blocks of a size class.
+        /// </summary>
+        static constexpr std::size_t SlabBytes = 256 * 1024;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        /// <summary>
+        /// Singly linked list of free blocks of the same size class.
+        /// </summary>
+        struct FreeList
+        {
+            FreeBlock* First = nullptr;
+            std::size_t Count = 0;
+
+            void Push(void* const ptr)
+            {
+                FreeBlock* const block = (FreeBlock*)ptr;
+                block->Next = First;
+                First = block;
+                ++Count;
+            }
+            void* Pop()
+            {
+                FreeBlock* const block = First;
+                First = block->Next;
+                --Count;
+                return block;
+            }
+
+            /// <summary>
+            /// Move up to count blocks from this list to the front of another.
+            /// </summary>
+            void MoveTo(FreeList& other, std::size_t count)
+            {
+                while (count-- > 0 && First)
+                    other.Push(Pop());
+            }
+        };
+
+        /// <summary>
+        /// Free blocks shared by all threads.
+        /// </summary>
+        struct GlobalPool
+        {
+            std::mutex Mutexes[SizeClassCount];
+            FreeList Lists[SizeClassCount];
+
+            /// <summary>
+            /// Move a batch of free blocks of a size class to a thread cache list, allocating a new slab if the pool is empty.
+            /// </summary>
+            void Refill(const std::size_t sizeClass, FreeList& to)
+            {
+                const std::size_t blockSize = GetBlockSize(sizeClass);
+                const std::size_t batchCount = GetBatchCount(sizeClass);
+                std::lock_guard<std::mutex> lock(Mutexes[sizeClass]);
+                FreeList& list = Lists[sizeClass];
+                if (list.Count < batchCount)
+                {
+                    const std::size_t slabSize = std::max(blockSize * batchCount, SlabBytes);
+                    uint8* const slab = (uint8*)FMemory::Malloc(slabSize, std::min(blockSize, MaxBlockAlignment));
+                    for (std::size_t offset = 0; offset + blockSize <= slabSize; offset += blockSize)
+                        list.Push(slab + offset);
+                }
+                list.MoveTo(to, batchCount);
+            }
+
+            /// <summary>
+            /// Move a batch of free blocks of a size class from a thread cache list back to the pool.
+            /// </summary>
+            void Release(const std::size_t sizeClass, FreeList& from, const std::size_t count)
+            {
+                std::lock_guard<std::mutex> lock(Mutexes[sizeClass]);
+                from.MoveTo(Lists[sizeClass], count);
+            }
+        };
+
+        /// <summary>
+        /// Free blocks owned by a single thread. Returned to the global pool when the thread exits.
+        /// </summary>
+        struct ThreadCache
+        {
+            FreeList Lists[SizeClassCount];
+
+            ~ThreadCache()
+            {
+                GlobalPool& pool = GetGlobalPool();
+                for (std::size_t i = 0; i < SizeClassCount; ++i)
+                    if (Lists[i].Count > 0)
+                        pool.Release(i, Lists[i], Lists[i].Count);
+            }
+        };
+
+    public:
+
+        /// <summary>
+        /// Get the size class index of an allocation or -1 if it is not served by size classes.
+        /// </summary>
+        static NI_FORCEINLINE int GetSizeClass(const std::size_t size, const std::size_t alignment)
+        {
+            const std::size_t blockSize = std::max(std::max(size, alignment), MinBlockSize);
+            if (blockSize > MaxBlockSize || alignment > MaxBlockAlignment)
+                return -1;
+            return (int)std::bit_width(blockSize - 1) - (int)MinBlockSizeLog2;
+        }
+
+        static constexpr std::size_t GetBlockSize(const std::size_t sizeClass)
+        {
+            return MinBlockSize << sizeClass;
+        }
+
+        static constexpr std::size_t GetBatchCount(const std::size_t sizeClass)
+        {
+            return std::max<std::size_t>(1, BatchBytes / GetBlockSize(sizeClass));
+        }
+
+        static void* Allocate(const std::size_t size, const std::size_t alignment)
+        {
+            const int sizeClass = GetSizeClass(size, alignment);
+            if (sizeClass < 0)
+                return FMemory::Malloc(size, alignment);
+            FreeList& list = GetThreadCache().Lists[sizeClass];
+            if (list.Count == 0)
+                GetGlobalPool().Refill(sizeClass, list);
+            return list.Pop();
+        }
+
+        static void Deallocate(void* const ptr, const std::size_t size, const std::size_t alignment)
+        {
+            if (ptr == nullptr)
+                return;
+            const int sizeClass = GetSizeClass(size, alignment);
+            if (sizeClass < 0)
+            {
+                FMemory::Free(ptr);
+                return;
+            }
+            FreeList& list = GetThreadCache().Lists[sizeClass];
+            list.Push(ptr);
+            const std::size_t batchCount = GetBatchCount(sizeClass);
+            if (list.Count * GetBlockSize(sizeClass) > ThreadCacheBytes && list.Count > batchCount)
+                GetGlobalPool().Release(sizeClass, list, batchCount);
+        }
+
+        template<typename T>
+        static void* Allocate()
+        {
+            return Allocate(sizeof(T), alignof(T));
+        }
+
+        template<typename T>
+        static void Delete(T* const ptr)
+        {
+            if (ptr == nullptr)
+                return;
+            ptr->~T();
+            Deallocate(ptr, sizeof(T), alignof(T));
+        }
+
+    private:
+        static GlobalPool& GetGlobalPool()
+        {
+            // Never destroyed, thread caches may return their blocks after static destruction.
+            static GlobalPool* const pool = new GlobalPool();
+            return *pool;
+        }
+
+        static ThreadCache& GetThreadCache()
+        {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+    };
+}
@@ -0,0 +1,353 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Components.h"
+#include "Node.h"
+#include "NodeHandle.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Maintain a hierarchy of nodes inside a single chunk using CoParentInChunk and, when present in the chunk structure, CoChildrenInChunk.
+    /// The nodes of a chunk are kept sorted so that:
+    ///     Every parent comes before its children.
+    ///     The children of a node are adjacent, as CoChildrenInChunk requires.
+    /// Sorted chunks propagate data from parents to children in a single linear pass, see Propagate.
+    /// Works on any container that can add and remove nodes, ex.: a Bucket or a Bunch.
+    /// </summary>
+    template<typename TSize>
+    struct ChunkHierarchyT
+    {
+    public:
+        using Self_t = ChunkHierarchyT<TSize>;
+        using Size_t = TSize;
+        using CoParentInChunk_t = CoParentInChunkT<Size_t>;
+        using CoChildrenInChunk_t = CoChildrenInChunkT<Size_t>;
+        using CoChangeVersion_t = CoChangeVersionT<Size_t>;
+
+    public:
+        /// <summary>
+        /// Test if all parents come before their children and all children of a node are adjacent.
+        /// </summary>
+        template<typename TContainer>
+        static bool IsSorted(const TContainer& container)
+        {
+            const CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            ni_assertf(parents != nullptr, TEXT("ChunkHierarchy requires CoParentInChunk in the chunk structure."));
+            const Size_t nodeCount = container.GetNodeCount();
+            std_vector<Size_t> lastChildIndices(nodeCount, -1);
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                const Size_t parentIndex = parents[i].Index;
+                if (parentIndex < 0)
+                    continue;
+                if (parentIndex >= i)
+                    return false;
+                if (lastChildIndices[parentIndex] >= 0 && lastChildIndices[parentIndex] != i - 1)
+                    return false;
+                lastChildIndices[parentIndex] = i;
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Reorder the nodes of a container breadth-first: roots first in their current order, then the children
+        /// of each node in their current order, and rebuild CoChildrenInChunk.
+        /// Node components are only relocated if the order changes.
+        /// Notes:
+        ///     Node indices held outside the container are invalidated.
+        /// </summary>
+        template<typename TContainer>
+        static void Sort(TContainer& container)
+        {
+            SortAndRemap(container);
+        }
+
+        /// <summary>
+        /// Add nodes as the last children of a parent node, or as root nodes if parentIndex is -1.
+        /// The new nodes are default constructed and their CoParentInChunk set.
+        /// The container is only re-sorted when the new nodes cannot be appended right after the parent's current children.
+        /// Returns the index of the first new node, the new nodes are adjacent.
+        /// Notes:
+        ///     When re-sorted, node indices held outside the container are invalidated, parentIndex included.
+        /// </summary>
+        template<typename TContainer>
+        static Size_t AddChildren(TContainer& container, const Size_t parentIndex, const NodeCountT<Size_t> nodeCount = NodeCountT<Size_t>::V_1())
+        {
+            ni_assert(parentIndex < container.GetNodeCount());
+            ni_assert(nodeCount >= 0);
+            const Size_t firstIndex = container.AddNodes(nodeCount);
+            if (firstIndex < 0 || nodeCount == 0)
+                return firstIndex;
+
+            CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            ni_assertf(parents != nullptr, TEXT("ChunkHierarchy requires CoParentInChunk in the chunk structure."));
+            for (Size_t i = firstIndex; i < firstIndex + nodeCount; ++i)
+                parents[i].Index = parentIndex;
+
+            // Appending keeps the container sorted for new roots, when the parent has no children yet
+            // or when the parent's last child is the previous last node.
+            CoChildrenInChunk_t* const nodeChildren = container.template GetComponentData<CoChildrenInChunk_t>();
+            const bool isAppendSorted = parentIndex < 0
+                || parents[firstIndex - 1].Index == parentIndex
+                || (nodeChildren != nullptr ? nodeChildren[parentIndex].Count == 0 : !HasChildren(parents, parentIndex, firstIndex - 1));
+            if (!isAppendSorted)
+            {
+                // Breadth-first sorting keeps the order of the parent's children, the new nodes stay adjacent.
+                const std_vector<Size_t> newIndices = SortAndRemap(container);
+                return newIndices.empty() ? firstIndex : newIndices[firstIndex];
+            }
+            if (nodeChildren != nullptr)
+            {
+                for (Size_t i = firstIndex; i < firstIndex + nodeCount; ++i)
+                    SetNoChildren(nodeChildren[i]);
+                if (parentIndex >= 0)
+                {
+                    if (nodeChildren[parentIndex].Count == 0)
+                        nodeChildren[parentIndex].FirstIndex = firstIndex;
+                    nodeChildren[parentIndex].Count += nodeCount;
+                }
+            }
+            return firstIndex;
+        }
+
+        /// <summary>
+        /// Remove a node and all its descendants.
+        /// Remaining nodes keep their relative order so the container stays sorted.
+        /// Notes:
+        ///     Node indices held outside the container are invalidated.
+        /// </summary>
+        template<typename TContainer>
+        static void RemoveSubtree(TContainer& container, const Size_t nodeIndex)
+        {
+            ni_assert(nodeIndex >= 0);
+            ni_assert(nodeIndex < container.GetNodeCount());
+            ni_assert(IsSorted(container));
+            CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            const Size_t nodeCount = container.GetNodeCount();
+
+            // Parents come before their children, a single forward pass finds all descendants.
+            std_vector<bool> isRemoved(nodeCount, false);
+            isRemoved[nodeIndex] = true;
+            for (Size_t i = nodeIndex + 1; i < nodeCount; ++i)
+                isRemoved[i] = parents[i].Index >= 0 && isRemoved[parents[i].Index];
+
+            // Nodes before nodeIndex are kept in place, the kept nodes after it are packed in front of the removed ones.
+            std_vector<Size_t> order;
+            order.reserve(nodeCount - nodeIndex);
+            std_vector<Size_t> newIndices(nodeCount, -1);
+            for (Size_t i = 0; i < nodeIndex; ++i)
+                newIndices[i] = i;
+            for (Size_t i = nodeIndex; i < nodeCount; ++i)
+                if (!isRemoved[i])
+                {
+                    newIndices[i] = nodeIndex + (Size_t)order.size();
+                    order.push_back(i - nodeIndex);
+                }
+            const Size_t keptCount = nodeIndex + (Size_t)order.size();
+            for (Size_t i = nodeIndex; i < nodeCount; ++i)
+                if (isRemoved[i])
+                    order.push_back(i - nodeIndex);
+
+            Node_t<TContainer>::PermuteAllNodeComponentsUnsafe(container, nodeIndex, order.data(), PropNodeCountT<Size_t>(nodeCount - nodeIndex));
+            NodeHandleTableT<typename TContainer::ChunkStructure_t>::UpdateNodes(container, nodeIndex, nodeCount - nodeIndex);
+            StampChanged(container);
+            container.RemoveNode(keptCount, PropNodeCountT<Size_t>(nodeCount - keptCount));
+            for (Size_t i = nodeIndex; i < keptCount; ++i)
+                if (parents[i].Index >= 0)
+                    parents[i].Index = newIndices[parents[i].Index];
+            UpdateChildren(container);
+        }
+
+        /// <summary>
+        /// Move a node and its descendants under a new parent, or make it a root node if parentIndex is -1, then re-sort the container.
+        /// Notes:
+        ///     parentIndex must not be nodeIndex or one of its descendants.
+        ///     Node indices held outside the container are invalidated.
+        /// </summary>
+        template<typename TContainer>
+        static void SetParent(TContainer& container, const Size_t nodeIndex, const Size_t parentIndex)
+        {
+            ni_assert(nodeIndex >= 0);
+            ni_assert(nodeIndex < container.GetNodeCount());
+            ni_assert(parentIndex < container.GetNodeCount());
+            CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            ni_assertf(parents != nullptr, TEXT("ChunkHierarchy requires CoParentInChunk in the chunk structure."));
+            for (Size_t ancestor = parentIndex; ancestor >= 0; ancestor = parents[ancestor].Index)
+            {
+                ni_assertf(ancestor != nodeIndex, TEXT("Cannot parent a node to itself or one of its descendants."));
+            }
+            if (parents[nodeIndex].Index == parentIndex)
+                return;
+            parents[nodeIndex].Index = parentIndex;
+            if (SortAndRemap(container).empty())
+                StampChanged(container);
+        }
+
+        /// <summary>
+        /// Call function(parentIndex, nodeIndex) once per node in index order, parentIndex being -1 for root nodes.
+        /// On a sorted container every parent is visited before its children.
+        /// </summary>
+        template<typename TContainer, typename TFunction>
+        static void Propagate(TContainer& container, TFunction&& function)
+        {
+            const CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            ni_assertf(parents != nullptr, TEXT("ChunkHierarchy requires CoParentInChunk in the chunk structure."));
+            const Size_t nodeCount = container.GetNodeCount();
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                ni_assert(parents[i].Index < i);
+                function(parents[i].Index, i);
+            }
+        }
+
+        /// <summary>
+        /// Compute a TOut component of every node from its own TIn component and its parent's already computed TOut component,
+        /// in a single linear pass over a sorted container.
+        /// function(const TOut* parentOut, const TIn& in, TOut& out) gets a null parentOut for root nodes.
+        /// Ex.: local-to-world transforms with TIn a local transform and TOut a world transform.
+        /// </summary>
+        template<typename TIn, typename TOut, typename TContainer, typename TFunction>
+        static void PropagateComponent(TContainer& container, TFunction&& function)
+        {
+            const CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            const TIn* const in = container.template GetComponentData<TIn>();
+            TOut* const out = container.template GetComponentData<TOut>();
+            ni_assertf(parents != nullptr, TEXT("ChunkHierarchy requires CoParentInChunk in the chunk structure."));
+            ni_assertf(in != nullptr && out != nullptr, TEXT("Could not find the propagated components in the chunk structure."));
+            const Size_t nodeCount = container.GetNodeCount();
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                const Size_t parentIndex = parents[i].Index;
+                ni_assert(parentIndex < i);
+                function(parentIndex >= 0 ? &out[parentIndex] : nullptr, in[i], out[i]);
+            }
+        }
+
+#ifndef PNC_PROPS_STRICT
+        template<typename TContainer>
+        static Size_t AddChildren(TContainer& container, const Size_t parentIndex, const Size_t nodeCount)
+        {
+            return AddChildren(container, parentIndex, PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+    protected:
+        template<typename TContainer>
+        using Node_t = NodeT<typename TContainer::ChunkStructure_t>;
+
+        /// <summary>
+        /// Sort a container breadth-first, see Sort, and return the new index of each node by previous index.
+        /// Returns an empty array if the order did not change.
+        /// </summary>
+        template<typename TContainer>
+        static std_vector<Size_t> SortAndRemap(TContainer& container)
+        {
+            CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            ni_assertf(parents != nullptr, TEXT("ChunkHierarchy requires CoParentInChunk in the chunk structure."));
+            const Size_t nodeCount = container.GetNodeCount();
+
+            // Children of each node grouped by parent in index order
+            std_vector<Size_t> childrenFirst(nodeCount + 1, 0);
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                ni_assert(parents[i].Index < nodeCount);
+                if (parents[i].Index >= 0)
+                    ++childrenFirst[parents[i].Index + 1];
+            }
+            for (Size_t i = 0; i < nodeCount; ++i)
+                childrenFirst[i + 1] += childrenFirst[i];
+            std_vector<Size_t> children(childrenFirst[nodeCount]);
+            std_vector<Size_t> childrenEnd(childrenFirst.begin(), childrenFirst.end() - 1);
+            for (Size_t i = 0; i < nodeCount; ++i)
+                if (parents[i].Index >= 0)
+                    children[childrenEnd[parents[i].Index]++] = i;
+
+            std_vector<Size_t> order;
+            order.reserve(nodeCount);
+            for (Size_t i = 0; i < nodeCount; ++i)
+                if (parents[i].Index < 0)
+                    order.push_back(i);
+            for (Size_t i = 0; i < (Size_t)order.size(); ++i)
+                order.insert(order.end(), children.begin() + childrenFirst[order[i]], children.begin() + childrenFirst[order[i] + 1]);
+            ni_assertf((Size_t)order.size() == nodeCount, TEXT("CoParentInChunk indices contain a cycle."));
+
+            // Only relocate from the first node that moves
+            Size_t firstMovedIndex = 0;
+            while (firstMovedIndex < nodeCount && order[firstMovedIndex] == firstMovedIndex)
+                ++firstMovedIndex;
+            std_vector<Size_t> newIndices;
+            if (firstMovedIndex < nodeCount)
+            {
+                newIndices.resize(nodeCount);
+                for (Size_t i = 0; i < nodeCount; ++i)
+                    newIndices[order[i]] = i;
+                for (Size_t i = firstMovedIndex; i < nodeCount; ++i)
+                    order[i] -= firstMovedIndex;
+                Node_t<TContainer>::PermuteAllNodeComponentsUnsafe(container, firstMovedIndex, order.data() + firstMovedIndex, PropNodeCountT<Size_t>(nodeCount - firstMovedIndex));
+                NodeHandleTableT<typename TContainer::ChunkStructure_t>::UpdateNodes(container, firstMovedIndex, nodeCount - firstMovedIndex);
+                StampChanged(container);
+                for (Size_t i = 0; i < nodeCount; ++i)
+                    if (parents[i].Index >= 0)
+                        parents[i].Index = newIndices[parents[i].Index];
+            }
+            UpdateChildren(container);
+            return newIndices;
+        }
+
+        /// <summary>
+        /// Stamp all columns with a new ChangeVersion once nodes were moved or reparented, so algorithms with Changed filters
+        /// see the reordered nodes. Does nothing if the structure has no CoChangeVersion.
+        /// </summary>
+        template<typename TContainer>
+        static void StampChanged(TContainer& container)
+        {
+            CoChangeVersion_t* const changeVersion = container.template GetComponentData<CoChangeVersion_t>();
+            if (changeVersion != nullptr)
+                changeVersion->SetAllChanged(ChangeVersion::Increment());
+        }
+
+        static void SetNoChildren(CoChildrenInChunk_t& nodeChildren)
+        {
+            nodeChildren.FirstIndex = -1;
+            nodeChildren.Count = 0;
+        }
+
+        /// <summary>
+        /// Rebuild CoChildrenInChunk from CoParentInChunk on a sorted container, if the structure has it.
+        /// </summary>
+        template<typename TContainer>
+        static void UpdateChildren(TContainer& container)
+        {
+            CoChildrenInChunk_t* const nodeChildren = container.template GetComponentData<CoChildrenInChunk_t>();
+            if (nodeChildren == nullptr)
+                return;
+            const CoParentInChunk_t* const parents = container.template GetComponentData<CoParentInChunk_t>();
+            const Size_t nodeCount = container.GetNodeCount();
+            for (Size_t i = 0; i < nodeCount; ++i)
+                SetNoChildren(nodeChildren[i]);
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                const Size_t parentIndex = parents[i].Index;
+                if (parentIndex < 0)
+                    continue;
+                if (nodeChildren[parentIndex].Count == 0)
+                    nodeChildren[parentIndex].FirstIndex = i;
+                ++nodeChildren[parentIndex].Count;
+            }
+        }
+
+        /// <summary>
+        /// Test if a node has a child at an index up to lastIndex.
+        /// </summary>
+        static bool HasChildren(const CoParentInChunk_t* const parents, const Size_t nodeIndex, const Size_t lastIndex)
+        {
+            for (Size_t i = lastIndex; i > nodeIndex; --i)
+                if (parents[i].Index == nodeIndex)
+                    return true;
+            return false;
+        }
+    };
+}
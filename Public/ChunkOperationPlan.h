@@ -0,0 +1,320 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentTypeSet.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Precompiled operations to construct, destruct, copy, move and relocate the components' data of a ChunkStructure.
+    /// Built once when the structure is created: each component type's owner and triviality are resolved ahead of time
+    /// so executing an operation only runs memset / memcpy / memmove on trivial component types and
+    /// calls the non-trivial ones' functions directly.
+    /// Trivial component types laid out next to each other in a single memory block are grouped in spans
+    /// so operating on all nodes of a chunk filled to capacity takes a single memset / memcpy per span.
+    /// </summary>
+    template<typename TSize>
+    struct ChunkOperationPlanT
+    {
+    public:
+        using Self_t = ChunkOperationPlanT<TSize>;
+        using Size_t = TSize;
+        using ComponentTypeSet_t = ComponentTypeSetT<Size_t>;
+        using ComponentType_t = typename ComponentTypeSet_t::ComponentType_t;
+
+        /// <summary>
+        /// An operation on the data of a single component type.
+        /// Only the function matching the list the step is in is set, except copy-only types in MoveConstructSteps which only set Copy
+        /// and move-only types in CopyConstructSteps which set no function and are copied bitwise.
+        /// </summary>
+        struct Step
+        {
+            Size_t ComponentIndex;
+            Size_t Size;
+            FnDataProcessor<Size_t> Process;
+            FnDataMove<Size_t> Move;
+            FnDataCopy<Size_t> Copy;
+        };
+
+        /// <summary>
+        /// Consecutive steps on components' data laid out next to each other in memory.
+        /// </summary>
+        struct Span
+        {
+            Size_t FirstStep;
+            Size_t StepCount;
+            /// <summary>
+            /// Sum of the component size of all steps in the span.
+            /// </summary>
+            Size_t Size;
+        };
+
+        /// <summary>
+        /// Operations on all component types of a single owner.
+        /// Indices are node indices for node components and chunk indices for chunk components.
+        /// </summary>
+        struct OwnerPlan
+        {
+            /// <summary>
+            /// Trivially default constructible component types, constructed by zeroing their memory.
+            /// </summary>
+            std_vector<Step> ZeroConstructSteps;
+            std_vector<Span> ZeroConstructSpans;
+            std_vector<Step> ConstructSteps;
+            std_vector<Step> DestructSteps;
+
+            /// <summary>
+            /// Trivially copyable component types, and those neither copy nor move constructible, copied and moved with memcpy / memmove.
+            /// </summary>
+            std_vector<Step> MemCopySteps;
+            std_vector<Span> MemCopySpans;
+            std_vector<Step> CopyConstructSteps;
+            std_vector<Step> MoveConstructSteps;
+
+            /// <summary>
+            /// Trivially relocatable component types, relocated with memmove.
+            /// </summary>
+            std_vector<Step> MemRelocateSteps;
+            std_vector<Step> RelocateSteps;
+
+            std_vector<Step> AllSteps;
+
+        public:
+            /// <summary>
+            /// Construct components [firstIndex, firstIndex + count).
+            /// getData(componentIndex) returns the base pointer of a component type's data.
+            /// </summary>
+            template<typename TGetData>
+            void ConstructUnsafe(TGetData getData, const Size_t firstIndex, const Size_t count)const
+            {
+                if (count == 0) return;
+#ifdef NI_MEMORY_NODE_CONSTRUCTZERO
+                for (const Step& step : AllSteps)
+                    ZeroData(getData(step.ComponentIndex), step.Size, firstIndex, count);
+#else
+                for (const Span& span : ZeroConstructSpans)
+                {
+                    if (firstIndex == 0 && IsContiguous(getData, ZeroConstructSteps, span, count))
+                        std::memset(getData(ZeroConstructSteps[span.FirstStep].ComponentIndex), 0, (std::size_t)span.Size * count);
+                    else
+                        for (Size_t i = span.FirstStep; i < span.FirstStep + span.StepCount; ++i)
+                            ZeroData(getData(ZeroConstructSteps[i].ComponentIndex), ZeroConstructSteps[i].Size, firstIndex, count);
+                }
+#endif
+                for (const Step& step : ConstructSteps)
+                    step.Process(getData(step.ComponentIndex), firstIndex, count);
+            }
+
+            /// <summary>
+            /// Destruct components [firstIndex, firstIndex + count).
+            /// </summary>
+            template<typename TGetData>
+            void DestructUnsafe(TGetData getData, const Size_t firstIndex, const Size_t count)const
+            {
+                if (count == 0) return;
+                for (const Step& step : DestructSteps)
+                    step.Process(getData(step.ComponentIndex), firstIndex, count);
+#ifdef NI_MEMORY_NODE_DESTRUCTZERO
+                for (const Step& step : AllSteps)
+                    ZeroData(getData(step.ComponentIndex), step.Size, firstIndex, count);
+#endif
+            }
+
+            /// <summary>
+            /// Copy-construct components between 2 component data arrays.
+            /// </summary>
+            template<typename TGetDataTo, typename TGetDataFrom>
+            void CopyConstructUnsafe(TGetDataTo getDataTo, const Size_t firstIndexTo,
+                                     TGetDataFrom getDataFrom, const Size_t firstIndexFrom,
+                                     const Size_t count)const
+            {
+                if (count == 0) return;
+                for (const Span& span : MemCopySpans)
+                {
+                    if (firstIndexTo == 0 && firstIndexFrom == 0 
+                        && IsContiguous(getDataTo, MemCopySteps, span, count) && IsContiguous(getDataFrom, MemCopySteps, span, count))
+                    {
+                        const Size_t index = MemCopySteps[span.FirstStep].ComponentIndex;
+                        std::memcpy(getDataTo(index), getDataFrom(index), (std::size_t)span.Size * count);
+                    }
+                    else
+                        for (Size_t i = span.FirstStep; i < span.FirstStep + span.StepCount; ++i)
+                        {
+                            const Step& step = MemCopySteps[i];
+                            std::memcpy(GetData(getDataTo(step.ComponentIndex), step.Size, firstIndexTo),
+                                        GetData(getDataFrom(step.ComponentIndex), step.Size, firstIndexFrom),
+                                        (std::size_t)step.Size * count);
+                        }
+                }
+                for (const Step& step : CopyConstructSteps)
+                {
+                    if (step.Copy)
+                        step.Copy(getDataTo(step.ComponentIndex), firstIndexTo, getDataFrom(step.ComponentIndex), firstIndexFrom, count);
+                    else
+                        std::memcpy(GetData(getDataTo(step.ComponentIndex), step.Size, firstIndexTo),
+                                    GetData(getDataFrom(step.ComponentIndex), step.Size, firstIndexFrom),
+                                    (std::size_t)step.Size * count);
+                }
+            }
+
+            /// <summary>
+            /// Move-construct components between 2 component data arrays.
+            /// Notes:
+            ///     Both arrays CAN be the same but the ranges must not overlap forward.
+            /// </summary>
+            template<typename TGetDataTo, typename TGetDataFrom>
+            void MoveConstructForwardUnsafe(TGetDataTo getDataTo, const Size_t firstIndexTo,
+                                            TGetDataFrom getDataFrom, const Size_t firstIndexFrom,
+                                            const Size_t count)const
+            {
+                if (count == 0) return;
+                for (const Step& step : MemCopySteps)
+                    std::memmove(GetData(getDataTo(step.ComponentIndex), step.Size, firstIndexTo),
+                                 GetData(getDataFrom(step.ComponentIndex), step.Size, firstIndexFrom),
+                                 (std::size_t)step.Size * count);
+                for (const Step& step : MoveConstructSteps)
+                {
+                    if (step.Move)
+                        step.Move(getDataTo(step.ComponentIndex), firstIndexTo, getDataFrom(step.ComponentIndex), firstIndexFrom, count);
+                    else
+                        step.Copy(getDataTo(step.ComponentIndex), firstIndexTo, getDataFrom(step.ComponentIndex), firstIndexFrom, count);
+                }
+            }
+
+            /// <summary>
+            /// Relocate components between 2 component data arrays.
+            /// Notes:
+            ///     Both arrays CAN be the same but the ranges must not overlap forward.
+            ///     Components in the range moved from must be considered destructed afterward.
+            /// </summary>
+            template<typename TGetDataTo, typename TGetDataFrom>
+            void RelocateForwardUnsafe(TGetDataTo getDataTo, const Size_t firstIndexTo,
+                                       TGetDataFrom getDataFrom, const Size_t firstIndexFrom,
+                                       const Size_t count)const
+            {
+                if (count == 0) return;
+                for (const Step& step : MemRelocateSteps)
+                    std::memmove(GetData(getDataTo(step.ComponentIndex), step.Size, firstIndexTo),
+                                 GetData(getDataFrom(step.ComponentIndex), step.Size, firstIndexFrom),
+                                 (std::size_t)step.Size * count);
+                for (const Step& step : RelocateSteps)
+                    step.Move(getDataTo(step.ComponentIndex), firstIndexTo, getDataFrom(step.ComponentIndex), firstIndexFrom, count);
+            }
+
+        private:
+            /// <summary>
+            /// If the data of all steps in a span are laid out next to each other for count components, 
+            /// which is the case when the data of a single memory block were laid out for a capacity of count.
+            /// </summary>
+            template<typename TGetData>
+            static bool IsContiguous(TGetData getData, const std_vector<Step>& steps, const Span& span, const Size_t count)
+            {
+                if (span.StepCount == 1)
+                    return true;
+                const Step& last = steps[span.FirstStep + span.StepCount - 1];
+                const uint8* const begin = (const uint8*)getData(steps[span.FirstStep].ComponentIndex);
+                return (const uint8*)getData(last.ComponentIndex) == begin + (std::size_t)(span.Size - last.Size) * count;
+            }
+            static void* GetData(void* const base, const Size_t size, const Size_t index)
+            {
+                return (uint8*)base + (std::size_t)index * size;
+            }
+            static const void* GetData(const void* const base, const Size_t size, const Size_t index)
+            {
+                return (const uint8*)base + (std::size_t)index * size;
+            }
+            static void ZeroData(void* const base, const Size_t size, const Size_t firstIndex, const Size_t count)
+            {
+                std::memset(GetData(base, size, firstIndex), 0, (std::size_t)count * size);
+            }
+        };
+
+    public:
+        OwnerPlan Node;
+        OwnerPlan Chunk;
+
+    public:
+        const OwnerPlan& GetOwnerPlan(const ComponentOwner owner)const
+        {
+            return owner == ComponentOwner::Node ? Node : Chunk;
+        }
+
+        /// <summary>
+        /// Build the plan for a set of component types.
+        /// blockComponentIndex is the order in which the components' data are laid out in a single memory block.
+        /// Spans are only formed under NI_MEMORY_SINGLE_BLOCK, otherwise each span holds a single step.
+        /// </summary>
+        void Build(const ComponentTypeSet_t& components, const std_vector<Size_t>& blockComponentIndex)
+        {
+            Node = OwnerPlan();
+            Chunk = OwnerPlan();
+            // Block position of the last step added to each span list, to know if the next one is adjacent in memory.
+            Size_t lastZeroConstructPosition[2] = { -1, -1 };
+            Size_t lastMemCopyPosition[2] = { -1, -1 };
+            const Size_t count = (Size_t)blockComponentIndex.size();
+            for (Size_t position = 0; position < count; ++position)
+            {
+                const Size_t index = blockComponentIndex[position];
+                const ComponentType_t& componentType = *components[index];
+                const int owner = componentType.IsNodeComponent() ? 0 : 1;
+                OwnerPlan& plan = owner == 0 ? Node : Chunk;
+                const Step step = { index, componentType.GetSize(), nullptr, nullptr, nullptr };
+                plan.AllSteps.push_back(step);
+
+                // Value-initializing a trivially default constructible type zeroes it. Like ComponentTypeT::ConstructDataUnsafe,
+                // component types without a default constructor are left unconstructed.
+                if (componentType.IsTriviallyDefaultConstructible())
+                    AddSpanStep(plan.ZeroConstructSteps, plan.ZeroConstructSpans, lastZeroConstructPosition[owner], position, step);
+                else if (componentType.IsNonTrivialConstruct())
+                    plan.ConstructSteps.push_back(WithProcess(step, componentType.GetNonTrivialConstruct()));
+
+                if (!componentType.IsTriviallyDestructible() && componentType.IsNonTrivialDestruct())
+                    plan.DestructSteps.push_back(WithProcess(step, componentType.GetNonTrivialDestruct()));
+
+                // Component types neither copy nor move constructible are copied bitwise, as ComponentTypeT does.
+                // Copy-only component types are copied when moved, move-only ones are copied bitwise like ComponentTypeT::CopyConstructDataForwardUnsafe.
+                if (componentType.IsTriviallyCopyable() 
+                    || (!componentType.IsNonTrivialCopyConstruct() && !componentType.IsNonTrivialMoveConstruct()))
+                    AddSpanStep(plan.MemCopySteps, plan.MemCopySpans, lastMemCopyPosition[owner], position, step);
+                else
+                {
+                    plan.CopyConstructSteps.push_back(WithCopy(step, componentType.GetNonTrivialCopyConstructForward()));
+                    if (componentType.IsNonTrivialMoveConstruct())
+                        plan.MoveConstructSteps.push_back(WithMove(step, componentType.GetNonTrivialMoveConstructForward()));
+                    else
+                        plan.MoveConstructSteps.push_back(WithCopy(step, componentType.GetNonTrivialCopyConstructForward()));
+                }
+
+                if (componentType.IsNonTrivialRelocate())
+                    plan.RelocateSteps.push_back(WithMove(step, componentType.GetNonTrivialRelocateForward()));
+                else
+                    plan.MemRelocateSteps.push_back(step);
+            }
+        }
+
+    private:
+        static void AddSpanStep(std_vector<Step>& steps, std_vector<Span>& spans, Size_t& lastPosition, const Size_t position, const Step& step)
+        {
+#ifdef NI_MEMORY_SINGLE_BLOCK
+            const bool isAdjacent = !spans.empty() && lastPosition + 1 == position;
+#else
+            const bool isAdjacent = false;
+#endif
+            if (isAdjacent)
+            {
+                Span& span = spans.back();
+                ++span.StepCount;
+                span.Size += step.Size;
+            }
+            else
+                spans.push_back({ (Size_t)steps.size(), 1, step.Size });
+            steps.push_back(step);
+            lastPosition = position;
+        }
+        static Step WithProcess(Step step, const FnDataProcessor<Size_t> process) { step.Process = process; return step; }
+        static Step WithCopy(Step step, const FnDataCopy<Size_t> copy) { step.Copy = copy; return step; }
+        static Step WithMove(Step step, const FnDataMove<Size_t> move) { step.Move = move; return step; }
+    };
+}
@@ -4,9 +4,59 @@
 #pragma once
 #include "common.h"
 #include "ComponentTypeSet.h"
+#include "ChunkOperationPlan.h"
 
 namespace NiT
 {
+    /// <summary>
+    /// Dense index of a ChunkStructure instance, used to index flat per-structure tables such as router caches.
+    /// Assigned on first use so temporary structures, built only to look up an existing one, do not take an index.
+    /// A copy shares the index the original had when copied since it has the same component types, so per-structure tables
+    /// do not grow with each copy of a structure. Copying does not assign an index, a copy of a structure without one gets its own on first use.
+    /// </summary>
+    template<typename TSize>
+    struct ChunkStructureIndexT
+    {
+    public:
+        using Self_t = ChunkStructureIndexT<TSize>;
+        using Size_t = TSize;
+
+    private:
+        mutable std::atomic<Size_t> Value;
+
+    public:
+        ChunkStructureIndexT() : Value(-1) {}
+        ChunkStructureIndexT(const Self_t& other) : Value(other.Value.load(std::memory_order_acquire)) {}
+        Self_t& operator=(const Self_t& other)
+        {
+            Value.store(other.Value.load(std::memory_order_acquire), std::memory_order_release);
+            return *this;
+        }
+
+        Size_t Get()const
+        {
+            Size_t value = Value.load(std::memory_order_acquire);
+            if (value != -1)
+                return value;
+            const Size_t next = GetNext().fetch_add(1);
+            if (Value.compare_exchange_strong(value, next, std::memory_order_acq_rel))
+                return next;
+            return value;
+        }
+
+        /// <summary>
+        /// Get the number of indices assigned so far. All indices are less than this count.
+        /// </summary>
+        static Size_t GetCount() { return GetNext().load(); }
+
+    private:
+        static std::atomic<Size_t>& GetNext()
+        {
+            static std::atomic<Size_t> next(0);
+            return next;
+        }
+    };
+
     /// <summary>
     /// A ChunkStructure defines the types of components that compose a chunk.
     /// Pointers to ChunkStructure are used to uniquely identify the structure between chunks
@@ -19,6 +69,8 @@ namespace NiT
         using Size_t = TSize;
         using ComponentTypeSet_t = ComponentTypeSetT<TSize>;
         using ComponentType_t = typename ComponentTypeSet_t::ComponentType_t;
+        using ComponentMask_t = typename ComponentTypeSet_t::ComponentMask_t;
+        using OperationPlan_t = ChunkOperationPlanT<TSize>;
 
     public:
         /// <summary>
@@ -32,6 +84,60 @@ namespace NiT
         std_vector<Size_t> DestructibleChunkIndex;
         std_vector<Size_t> NodeComponentIndex;
         std_vector<Size_t> ChunkComponentIndex;
+
+        /// <summary>
+        /// Component indices sorted by decreasing alignment.
+        /// Order in which the components' data are laid out in a single memory block so no padding is required between them.
+        /// Components of the same alignment are grouped by owner and triviality so the operation plan can merge them in spans.
+        /// </summary>
+        std_vector<Size_t> BlockComponentIndex;
+
+        /// <summary>
+        /// Per component index, bytes per node and bytes per chunk of all components laid out before it in a single memory block.
+        /// Without padding, a component's data offset in a block is BlockNodeOffset * nodeCapacity + BlockChunkOffset * chunkCapacity.
+        /// </summary>
+        std_vector<Size_t> BlockNodeOffset;
+        std_vector<Size_t> BlockChunkOffset;
+
+        /// <summary>
+        /// Bytes per node and bytes per chunk of all components' data in a single memory block.
+        /// </summary>
+        Size_t BlockNodeSize;
+        Size_t BlockChunkSize;
+
+        /// <summary>
+        /// Alignment of a single memory block holding all components' data.
+        /// Greatest alignment of all component types in the structure.
+        /// </summary>
+        Size_t BlockAlignment;
+
+        /// <summary>
+        /// Operations to construct, destruct, copy, move and relocate the components' data of this structure.
+        /// </summary>
+        OperationPlan_t Plan;
+
+        /// <summary>
+        /// Structure with one more component type, per component type id, once resolved by a ChunkStructureRegistry.
+        /// Null when not resolved yet.
+        /// Only read and written under the lock of the ChunkStructureRegistry that interned this structure.
+        /// </summary>
+        mutable std_vector<const Self_t*> AddComponentEdges;
+
+        /// <summary>
+        /// Structure with one less component type, per component type id, once resolved by a ChunkStructureRegistry.
+        /// Null when not resolved yet.
+        /// Only read and written under the lock of the ChunkStructureRegistry that interned this structure.
+        /// </summary>
+        mutable std_vector<const Self_t*> RemoveComponentEdges;
+
+        ChunkStructureIndexT<Size_t> Index;
+
+#ifdef NI_MEMORY_STATS
+        /// <summary>
+        /// Memory allocated for components' data in all chunks of this structure.
+        /// </summary>
+        mutable MemoryStats Memory;
+#endif
     public:
 
         /// <summary>
@@ -62,6 +168,11 @@ namespace NiT
 
     public:
 
+        /// <summary>
+        /// Get the dense index of this ChunkStructure, unique among all ChunkStructure instances except copies of each other.
+        /// </summary>
+        Size_t GetIndex()const { return Index.Get(); }
+
         Size_t GetComponentCount() const { return Components.GetSize(); }
         const ComponentType_t& GetComponentType(const Size_t index)const
         {
@@ -76,6 +187,42 @@ namespace NiT
 
         Size_t GetComponentTypeIndexInChunk(const ComponentType_t* const type)const { return Components.GetComponentTypeIndexInChunk(type); }
 
+        /// <summary>
+        /// Get the index of a component type in the ComponentTypeSet of this ChunkStructure from its dense id, see ComponentTypeIdT.
+        /// </summary>
+        Size_t GetComponentTypeIndexInChunkById(const Size_t id)const { return Components.GetComponentTypeIndexInChunkById(id); }
+
+        template<typename T>
+        Size_t GetComponentTypeIndexInChunk()const { return Components.template GetComponentTypeIndexInChunk<T>(); }
+
+        /// <summary>
+        /// Get the bitmask of the ids of all component types in this ChunkStructure.
+        /// </summary>
+        const ComponentMask_t& GetMask()const { return Components.GetMask(); }
+
+        /// <summary>
+        /// If this ChunkStructure has all component types of a mask.
+        /// </summary>
+        bool HasAllComponents(const ComponentMask_t& mask)const { return Components.IsSupersetOf(mask); }
+
+        /// <summary>
+        /// If this ChunkStructure has at least one component type of a mask.
+        /// </summary>
+        bool HasAnyComponents(const ComponentMask_t& mask)const { return Components.Intersects(mask); }
+
+        /// <summary>
+        /// Get the cached structure with the component type id added, or null if not resolved yet.
+        /// </summary>
+        const Self_t* GetAddComponentEdge(const Size_t id)const { return GetEdge(AddComponentEdges, id); }
+
+        /// <summary>
+        /// Get the cached structure with the component type id removed, or null if not resolved yet.
+        /// </summary>
+        const Self_t* GetRemoveComponentEdge(const Size_t id)const { return GetEdge(RemoveComponentEdges, id); }
+
+        void SetAddComponentEdge(const Size_t id, const Self_t* const chunkStructure)const { SetEdge(AddComponentEdges, id, chunkStructure); }
+        void SetRemoveComponentEdge(const Size_t id, const Self_t* const chunkStructure)const { SetEdge(RemoveComponentEdges, id, chunkStructure); }
+
         /// <summary>
         /// If both structures are equal
         /// </summary>
@@ -86,6 +233,61 @@ namespace NiT
             return Components.IsSame(other.Components);
         }
 
+        /// <summary>
+        /// Get the size in bytes of a single memory block large enough to hold all components' data
+        /// for nodeCapacity nodes and chunkCapacity chunks.
+        /// </summary>
+        Size_t GetBlockSize(const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)const
+        {
+            return BlockNodeSize * nodeCapacity + BlockChunkSize * chunkCapacity;
+        }
+
+        /// <summary>
+        /// Get a component's data in a single memory block sized for nodeCapacity nodes and chunkCapacity chunks.
+        /// </summary>
+        void* GetBlockComponentData(void* const block, const Size_t componentIndex,
+                                    const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)const
+        {
+            return (void*)((uint8*)block + BlockNodeOffset[componentIndex] * nodeCapacity + BlockChunkOffset[componentIndex] * chunkCapacity);
+        }
+
+        /// <summary>
+        /// Call function(componentTypeIndexInChunk, componentData) for each component's data in a single memory block
+        /// sized for nodeCapacity nodes and chunkCapacity chunks.
+        /// Components are visited in BlockComponentIndex order.
+        /// </summary>
+        template<typename TFunction>
+        void ForEachBlockComponentData(void* const block,
+                                       const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity,
+                                       TFunction function)const
+        {
+            for (const Size_t index : BlockComponentIndex)
+                function(index, GetBlockComponentData(block, index, nodeCapacity, chunkCapacity));
+        }
+
+        /// <summary>
+        /// Set all void* in a ComponentDataArray to their component's data offset in a single memory block.
+        /// </summary>
+        void SetBlockComponentDataArray(void** const componentDataArray, void* const block,
+                                        const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)const
+        {
+            ForEachBlockComponentData(block, nodeCapacity, chunkCapacity, [componentDataArray](const Size_t index, void* const componentData)
+            {
+                componentDataArray[index] = componentData;
+            });
+        }
+
+        /// <summary>
+        /// Get the single memory block a ComponentDataArray was set to with SetBlockComponentDataArray.
+        /// Returns null if the structure has no component.
+        /// </summary>
+        void* GetBlock(void* const* const componentDataArray)const
+        {
+            if (BlockComponentIndex.empty())
+                return nullptr;
+            return componentDataArray[BlockComponentIndex[0]];
+        }
+
     public:
         struct Hasher_t
         {
@@ -105,6 +307,20 @@ namespace NiT
             }
         };
     protected:
+        static const Self_t* GetEdge(const std_vector<const Self_t*>& edges, const Size_t id)
+        {
+            if (id >= (Size_t)edges.size())
+                return nullptr;
+            return edges[id];
+        }
+
+        static void SetEdge(std_vector<const Self_t*>& edges, const Size_t id, const Self_t* const chunkStructure)
+        {
+            if (id >= (Size_t)edges.size())
+                edges.resize(id + 1, nullptr);
+            edges[id] = chunkStructure;
+        }
+
         void Update() 
         {
             Components.SubSetIndex(&DefaultConstructibleNodeIndex, [](const ComponentType_t* c) { return c->IsNonTrivialConstruct() && c->IsNodeComponent(); });
@@ -113,6 +329,40 @@ namespace NiT
             Components.SubSetIndex(&DestructibleChunkIndex, [](const ComponentType_t* c) { return c->IsNonTrivialDestruct() && c->IsChunkComponent(); });
             Components.SubSetIndex(&NodeComponentIndex, [](const ComponentType_t* c) { return c->IsNodeComponent(); });
             Components.SubSetIndex(&ChunkComponentIndex, [](const ComponentType_t* c) { return c->IsChunkComponent(); });
+
+            Components.SubSetIndex(&BlockComponentIndex, [](const ComponentType_t* c) { return true; });
+            std::stable_sort(BlockComponentIndex.begin(), BlockComponentIndex.end(), [this](const Size_t a, const Size_t b)
+            {
+                const ComponentType_t& typeA = GetComponentType(a);
+                const ComponentType_t& typeB = GetComponentType(b);
+                if (typeA.GetAlignment() != typeB.GetAlignment())
+                    return typeA.GetAlignment() > typeB.GetAlignment();
+                if (typeA.GetOwner() != typeB.GetOwner())
+                    return typeA.GetOwner() < typeB.GetOwner();
+                if (typeA.IsTriviallyCopyable() != typeB.IsTriviallyCopyable())
+                    return typeA.IsTriviallyCopyable();
+                return typeA.IsTriviallyDefaultConstructible() && !typeB.IsTriviallyDefaultConstructible();
+            });
+            BlockAlignment = BlockComponentIndex.empty() ? 1 : GetComponentType(BlockComponentIndex[0]).GetAlignment();
+
+            BlockNodeOffset.assign(GetComponentCount(), 0);
+            BlockChunkOffset.assign(GetComponentCount(), 0);
+            BlockNodeSize = 0;
+            BlockChunkSize = 0;
+            for (const Size_t index : BlockComponentIndex)
+            {
+                const ComponentType_t& componentType = GetComponentType(index);
+                // Sizes are multiples of alignments and alignments are decreasing, no padding is ever needed.
+                ni_assert(componentType.GetSize() % componentType.GetAlignment() == 0);
+                BlockNodeOffset[index] = BlockNodeSize;
+                BlockChunkOffset[index] = BlockChunkSize;
+                if (componentType.IsNodeComponent())
+                    BlockNodeSize += componentType.GetSize();
+                else
+                    BlockChunkSize += componentType.GetSize();
+            }
+
+            Plan.Build(Components, BlockComponentIndex);
         }
     };
 }
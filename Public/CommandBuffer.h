@@ -0,0 +1,357 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Registry.h"
+#include <thread>
+
+// Number of CommandBufferSets whose buffer a thread finds without a lock in GetLocal.
+#ifndef NI_COMMAND_BUFFER_LOCAL_CACHE
+#   define NI_COMMAND_BUFFER_LOCAL_CACHE 4
+#endif
+
+namespace NiT
+{
+    /// <summary>
+    /// Record structural changes on the chunks of a registry to apply them later with Playback,
+    /// once no algorithm accesses the chunks anymore.
+    /// Node indices recorded are the indices at the time of recording, they stay valid until Playback.
+    /// A CommandBuffer is recorded by a single thread, use a CommandBufferSet to record from multiple threads.
+    /// </summary>
+    /// <typeparam name="TRegistry">PncRegistryT or ChunkRegistryT owning the chunks</typeparam>
+    template<typename TRegistry>
+    struct CommandBufferT
+    {
+    public:
+        using Self_t = CommandBufferT<TRegistry>;
+        using Registry_t = TRegistry;
+        using Chunk_t = typename Registry_t::Chunk_t;
+        using ChunkStructure_t = typename Chunk_t::ChunkStructure_t;
+        using Size_t = typename ChunkStructure_t::Size_t;
+
+        enum class CommandType : uint8
+        {
+            NewChunk,
+            RemoveNode,
+            MigrateNodes,
+            AddNodes,
+            DeleteChunk,
+        };
+
+        struct Command
+        {
+            CommandType Type;
+
+            /// <summary>
+            /// Chunk the nodes are added to, removed from or migrated from.
+            /// </summary>
+            Chunk_t* Chunk;
+
+            /// <summary>
+            /// Chunk nodes are migrated to.
+            /// </summary>
+            Chunk_t* ChunkTo;
+
+            const ChunkStructure_t* Structure;
+            Size_t NodeIndex;
+            Size_t NodeCount;
+        };
+
+    protected:
+        template<typename TRegistryFriend>
+        friend struct CommandBufferSetT;
+
+        std_vector<Command> Commands;
+        Size_t NewChunkCount = 0;
+        std_vector<Chunk_t*> NewChunks;
+
+    public:
+        bool IsEmpty()const { return Commands.empty(); }
+        Size_t GetCommandCount()const { return (Size_t)Commands.size(); }
+
+        /// <summary>
+        /// Record the creation of a new chunk and return its index in GetNewChunks() after Playback.
+        /// </summary>
+        Size_t NewChunk(const ChunkStructure_t* const chunkStructure, const NodeCountT<Size_t> nodeCount)
+        {
+            Commands.push_back(Command{ CommandType::NewChunk, nullptr, nullptr, chunkStructure, 0, nodeCount });
+            return NewChunkCount++;
+        }
+
+        void DeleteChunk(Chunk_t* const chunk)
+        {
+            Commands.push_back(Command{ CommandType::DeleteChunk, chunk, nullptr, nullptr, 0, 0 });
+        }
+
+        void AddNodes(Chunk_t* const chunk, const NodeCountT<Size_t> nodeCount)
+        {
+            Commands.push_back(Command{ CommandType::AddNodes, chunk, nullptr, nullptr, 0, nodeCount });
+        }
+
+        void RemoveNode(Chunk_t* const chunk, const Size_t firstNodeIndex, const NodeCountT<Size_t> nodeCount = NodeCountT<Size_t>::V_1())
+        {
+            Commands.push_back(Command{ CommandType::RemoveNode, chunk, nullptr, nullptr, firstNodeIndex, nodeCount });
+        }
+
+        /// <summary>
+        /// Record moving a range of nodes from a chunk to the end of another chunk of any structure.
+        /// </summary>
+        void MigrateNodes(Chunk_t* const chunkTo, Chunk_t* const chunkFrom, const Size_t firstNodeIndexFrom, const NodeCountT<Size_t> nodeCount)
+        {
+            Commands.push_back(Command{ CommandType::MigrateNodes, chunkFrom, chunkTo, nullptr, firstNodeIndexFrom, nodeCount });
+        }
+
+#ifndef PNC_PROPS_STRICT
+        Size_t NewChunk(const ChunkStructure_t* const chunkStructure, const Size_t nodeCount) { return NewChunk(chunkStructure, PropNodeCountT<Size_t>(nodeCount)); }
+        void AddNodes(Chunk_t* const chunk, const Size_t nodeCount) { AddNodes(chunk, PropNodeCountT<Size_t>(nodeCount)); }
+        void RemoveNode(Chunk_t* const chunk, const Size_t firstNodeIndex, const Size_t nodeCount) { RemoveNode(chunk, firstNodeIndex, PropNodeCountT<Size_t>(nodeCount)); }
+        void MigrateNodes(Chunk_t* const chunkTo, Chunk_t* const chunkFrom, const Size_t firstNodeIndexFrom, const Size_t nodeCount) { MigrateNodes(chunkTo, chunkFrom, firstNodeIndexFrom, PropNodeCountT<Size_t>(nodeCount)); }
+#endif
+
+        /// <summary>
+        /// Move all commands of another buffer at the end of this buffer.
+        /// </summary>
+        void Append(Self_t& other)
+        {
+            Commands.insert(Commands.end(), other.Commands.begin(), other.Commands.end());
+            NewChunkCount += other.NewChunkCount;
+            other.Commands.clear();
+            other.NewChunkCount = 0;
+        }
+
+        /// <summary>
+        /// Chunks created by the last Playback, in NewChunk recording order.
+        /// </summary>
+        const std_vector<Chunk_t*>& GetNewChunks()const { return NewChunks; }
+
+        /// <summary>
+        /// Apply all recorded commands on the registry's chunks and clear the buffer.
+        /// Commands are sorted by chunk and applied in batches:
+        ///     New chunks are created first.
+        ///     Chunks that grow are reserved once for all their added and migrated nodes.
+        ///     Removed and migrated node ranges are applied per chunk from the highest index down, so each
+        ///     trailing node is moved at most once and recorded indices stay valid during the pass.
+        ///     Consecutive removed ranges of a chunk are removed together with a single RemoveNodes.
+        ///     Added nodes are then constructed and deleted chunks are deleted last.
+        /// Node ranges removed or migrated from the same chunk must not overlap.
+        /// </summary>
+        void Playback(Registry_t& registry)
+        {
+            NewChunks.clear();
+            for (const Command& command : Commands)
+                if (command.Type == CommandType::NewChunk)
+                    NewChunks.push_back(registry.NewChunk(command.Structure, PropNodeCountT<Size_t>(command.NodeCount)));
+
+            // Group by chunk, then by type in the order they are applied, then by decreasing node index.
+            std::sort(Commands.begin(), Commands.end(), [](const Command& a, const Command& b)
+            {
+                if (a.Chunk != b.Chunk)
+                    return std::less<Chunk_t*>()(a.Chunk, b.Chunk);
+                const bool aIsRemoving = a.Type == CommandType::RemoveNode || a.Type == CommandType::MigrateNodes;
+                const bool bIsRemoving = b.Type == CommandType::RemoveNode || b.Type == CommandType::MigrateNodes;
+                if (aIsRemoving != bIsRemoving)
+                    return aIsRemoving;
+                if (aIsRemoving)
+                    return a.NodeIndex > b.NodeIndex;
+                return a.Type < b.Type;
+            });
+
+            ReserveGrowingChunks();
+
+            std_vector<Size_t> removedNodeIndices;
+            for (std::size_t i = 0; i < Commands.size(); ++i)
+            {
+                const Command& command = Commands[i];
+                switch (command.Type)
+                {
+                case CommandType::RemoveNode:
+                {
+                    // All ranges of the group are above any range applied after it and below NodeCount once removed,
+                    // so compacting them at once leaves the indices of the following ranges valid.
+                    std::size_t groupEnd = i + 1;
+                    while (groupEnd < Commands.size() && Commands[groupEnd].Type == CommandType::RemoveNode && Commands[groupEnd].Chunk == command.Chunk)
+                        ++groupEnd;
+                    if (groupEnd == i + 1)
+                    {
+                        command.Chunk->RemoveNode(command.NodeIndex, PropNodeCountT<Size_t>(command.NodeCount));
+                        break;
+                    }
+                    removedNodeIndices.clear();
+                    for (std::size_t j = i; j < groupEnd; ++j)
+                        for (Size_t n = 0; n < Commands[j].NodeCount; ++n)
+                            removedNodeIndices.push_back(Commands[j].NodeIndex + n);
+                    command.Chunk->RemoveNodes(removedNodeIndices.data(), PropNodeCountT<Size_t>((Size_t)removedNodeIndices.size()));
+                    i = groupEnd - 1;
+                    break;
+                }
+                case CommandType::MigrateNodes:
+                {
+                    const Size_t firstIndex = command.ChunkTo->MigrateNodes(*command.Chunk, command.NodeIndex, PropNodeCountT<Size_t>(command.NodeCount));
+                    ni_assertf(firstIndex >= 0, TEXT("Could not migrate nodes, the destination chunk is full."));
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+            for (const Command& command : Commands)
+                if (command.Type == CommandType::AddNodes)
+                {
+                    const Size_t firstIndex = command.Chunk->AddNodes(PropNodeCountT<Size_t>(command.NodeCount));
+                    ni_assertf(firstIndex >= 0, TEXT("Could not add nodes, the chunk is full."));
+                }
+            for (const Command& command : Commands)
+                if (command.Type == CommandType::DeleteChunk)
+                    registry.DeleteChunk(command.Chunk);
+            Commands.clear();
+            NewChunkCount = 0;
+        }
+
+    protected:
+        /// <summary>
+        /// Reserve once the final NodeCapacity of every chunk that can grow and receives added or migrated nodes.
+        /// </summary>
+        void ReserveGrowingChunks()
+        {
+            if constexpr (requires(Chunk_t& chunk) { chunk.Reserve(NodeCapacityT<Size_t>::V_0()); })
+            {
+                std_unordered_map<Chunk_t*, Size_t> addedNodeCounts;
+                for (const Command& command : Commands)
+                {
+                    if (command.Type == CommandType::AddNodes)
+                        addedNodeCounts[command.Chunk] += command.NodeCount;
+                    else if (command.Type == CommandType::MigrateNodes)
+                        addedNodeCounts[command.ChunkTo] += command.NodeCount;
+                }
+                for (const auto& [chunk, addedNodeCount] : addedNodeCounts)
+                {
+                    const Size_t nodeCount = chunk->GetNodeCount();
+                    if (nodeCount + addedNodeCount > chunk->GetNodeCapacity())
+                        chunk->Reserve(PropCountToCapacity(PropNodeCountT<Size_t>(nodeCount + addedNodeCount)));
+                }
+            }
+        }
+    };
+
+    /// <summary>
+    /// One CommandBuffer per recording thread, so algorithms running concurrently can record structural changes without locking.
+    /// A thread's buffer is created on its first GetLocal() call. Each thread caches the buffers of the last
+    /// NI_COMMAND_BUFFER_LOCAL_CACHE sets it recorded in, only other calls take a lock to find the thread's buffer in the set.
+    /// Playback merges all buffers and must be called once all recording threads are done.
+    /// It releases the buffers of threads that recorded nothing since the previous Playback, so the set does not grow
+    /// with every thread that ever recorded in it: a buffer from GetLocal must not be used after the next Playback it did not record for.
+    /// </summary>
+    template<typename TRegistry>
+    struct CommandBufferSetT
+    {
+    public:
+        using Self_t = CommandBufferSetT<TRegistry>;
+        using Registry_t = TRegistry;
+        using CommandBuffer_t = CommandBufferT<Registry_t>;
+        using Chunk_t = typename CommandBuffer_t::Chunk_t;
+        using Size_t = typename CommandBuffer_t::Size_t;
+
+    protected:
+        /// <summary>
+        /// Unique per set, so a thread never reuses a cached buffer of a destroyed set created at the same address.
+        /// </summary>
+        uint64 Id;
+        std::mutex BuffersMutex;
+        std_vector<Unique_Ptr<CommandBuffer_t>> Buffers;
+        std_unordered_map<std::thread::id, CommandBuffer_t*> ThreadBuffers;
+        CommandBuffer_t Merged;
+
+    public:
+        CommandBufferSetT()
+            : Id(GetNextId())
+        {
+        }
+
+        CommandBufferSetT(const Self_t&) = delete;
+        Self_t& operator=(const Self_t&) = delete;
+
+        /// <summary>
+        /// Get the calling thread's CommandBuffer.
+        /// </summary>
+        CommandBuffer_t& GetLocal()
+        {
+            struct LocalCacheEntry
+            {
+                uint64 SetId = 0;
+                CommandBuffer_t* Buffer = nullptr;
+            };
+            // Most recently used set first.
+            thread_local LocalCacheEntry cache[NI_COMMAND_BUFFER_LOCAL_CACHE];
+            std::size_t entry = 0;
+            while (entry < NI_COMMAND_BUFFER_LOCAL_CACHE - 1 && cache[entry].SetId != Id)
+                ++entry;
+            if (cache[entry].SetId != Id)
+            {
+                std::lock_guard<std::mutex> lock(BuffersMutex);
+                CommandBuffer_t*& buffer = ThreadBuffers[std::this_thread::get_id()];
+                if (buffer == nullptr)
+                    buffer = Buffers.emplace_back(std_make_unique<CommandBuffer_t>()).get();
+                cache[entry] = LocalCacheEntry{ Id, buffer };
+            }
+            const LocalCacheEntry found = cache[entry];
+            for (; entry > 0; --entry)
+                cache[entry] = cache[entry - 1];
+            cache[0] = found;
+            return *found.Buffer;
+        }
+
+        /// <summary>
+        /// Apply the commands of all threads' buffers, see CommandBufferT::Playback.
+        /// Each thread's buffer then gets the chunks it recorded with NewChunk in its own GetNewChunks().
+        /// </summary>
+        void Playback(Registry_t& registry)
+        {
+            std::lock_guard<std::mutex> lock(BuffersMutex);
+            ReleaseIdleBuffers();
+            std_vector<Size_t> newChunkCounts;
+            newChunkCounts.reserve(Buffers.size());
+            for (const Unique_Ptr<CommandBuffer_t>& buffer : Buffers)
+            {
+                newChunkCounts.push_back(buffer->NewChunkCount);
+                Merged.Append(*buffer);
+            }
+            Merged.Playback(registry);
+            auto newChunk = Merged.NewChunks.begin();
+            for (std::size_t i = 0; i < Buffers.size(); ++i)
+            {
+                Buffers[i]->NewChunks.assign(newChunk, newChunk + newChunkCounts[i]);
+                newChunk += newChunkCounts[i];
+            }
+        }
+
+    protected:
+        /// <summary>
+        /// Release the buffers without commands, their thread may be gone.
+        /// The set takes a new Id so threads do not find released buffers in their cache.
+        /// </summary>
+        void ReleaseIdleBuffers()
+        {
+            for (auto i = ThreadBuffers.begin(); i != ThreadBuffers.end();)
+            {
+                if (i->second->IsEmpty())
+                    i = ThreadBuffers.erase(i);
+                else
+                    ++i;
+            }
+            Buffers.erase(std::remove_if(Buffers.begin(), Buffers.end(), [](const Unique_Ptr<CommandBuffer_t>& buffer) { return buffer->IsEmpty(); }), Buffers.end());
+            Id = GetNextId();
+        }
+
+        static uint64 GetNextId()
+        {
+            static std::atomic<uint64> nextId(1);
+            return nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+}
+namespace Ni
+{
+    using CommandBuffer = NiT::CommandBufferT<PncRegistry>;
+    using CommandBufferSet = NiT::CommandBufferSetT<PncRegistry>;
+}
@@ -0,0 +1,57 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentMask.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Component types an algorithm reads and writes.
+    /// Algorithms declare a read with Component(const T*&) and a write with Component(T*&) in their Requirements.
+    /// </summary>
+    template<typename TSize>
+    struct ComponentAccessT
+    {
+    public:
+        using Self_t = ComponentAccessT<TSize>;
+        using Size_t = TSize;
+        using ComponentMask_t = ComponentMaskT<Size_t>;
+
+    public:
+        ComponentMask_t Read;
+        ComponentMask_t Write;
+
+    public:
+        /// <summary>
+        /// Add a read of T if T is const, otherwise a write of T.
+        /// </summary>
+        template<typename T>
+        void Add()
+        {
+            if (std::is_const_v<T>)
+                Read.template Set<T>();
+            else
+                Write.template Set<T>();
+        }
+
+        /// <summary>
+        /// If both accesses cannot run concurrently on the same data: 
+        /// one of them writes a component type the other reads or writes.
+        /// </summary>
+        bool ConflictsWith(const Self_t& other)const
+        {
+            return Write.Intersects(other.Write) 
+                || Write.Intersects(other.Read) 
+                || Read.Intersects(other.Write);
+        }
+
+        Self_t& operator|=(const Self_t& other)
+        {
+            Read |= other.Read;
+            Write |= other.Write;
+            return *this;
+        }
+    };
+}
@@ -0,0 +1,184 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentType.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// A set of component type ids, see ComponentTypeIdT, stored as a fixed-width bitmask.
+    /// Set queries are a few word-wise AND/compare over NI_COMPONENT_MASK_BITS bits.
+    /// Ids that do not fit in the bits are kept in a sorted overflow list so queries stay exact.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template<typename TSize>
+    struct ComponentMaskT
+    {
+    public:
+        using Self_t = ComponentMaskT<TSize>;
+        using Size_t = TSize;
+        using Word_t = uint64;
+
+        static constexpr Size_t BitCount = NI_COMPONENT_MASK_BITS;
+        static constexpr Size_t WordBitCount = sizeof(Word_t) * 8;
+        static constexpr Size_t WordCount = BitCount / WordBitCount;
+        static_assert(BitCount > 0 && BitCount % WordBitCount == 0, "NI_COMPONENT_MASK_BITS must be a non-zero multiple of 64.");
+
+    private:
+        Word_t Words[WordCount];
+
+        /// <summary>
+        /// Sorted ids greater or equal to BitCount. Empty unless more than BitCount component types exist.
+        /// </summary>
+        std_vector<Size_t> Overflow;
+
+    public:
+        ComponentMaskT()
+            : Words()
+            , Overflow()
+        {
+        }
+
+        bool operator==(const Self_t& other)const { return IsSame(other); }
+        bool operator!=(const Self_t& other)const { return !IsSame(other); }
+
+    public:
+        /// <summary>
+        /// Add a component type id to the mask.
+        /// </summary>
+        void Set(const Size_t id)
+        {
+            ni_assert(id >= 0);
+            if (id < BitCount)
+            {
+                Words[id / WordBitCount] |= Word_t(1) << (id % WordBitCount);
+                return;
+            }
+            auto i = std::lower_bound(Overflow.begin(), Overflow.end(), id);
+            if (i == Overflow.end() || *i != id)
+                Overflow.insert(i, id);
+        }
+
+        /// <summary>
+        /// If the mask includes a component type id.
+        /// </summary>
+        bool Test(const Size_t id)const
+        {
+            if (id < BitCount)
+                return (Words[id / WordBitCount] >> (id % WordBitCount)) & 1;
+            return std::binary_search(Overflow.begin(), Overflow.end(), id);
+        }
+
+        void Clear()
+        {
+            for (Size_t i = 0; i < WordCount; ++i)
+                Words[i] = 0;
+            Overflow.clear();
+        }
+
+        bool IsEmpty()const
+        {
+            Word_t any = 0;
+            for (Size_t i = 0; i < WordCount; ++i)
+                any |= Words[i];
+            return any == 0 && Overflow.empty();
+        }
+
+        /// <summary>
+        /// If both masks include the exact same ids.
+        /// </summary>
+        bool IsSame(const Self_t& other)const
+        {
+            Word_t diff = 0;
+            for (Size_t i = 0; i < WordCount; ++i)
+                diff |= Words[i] ^ other.Words[i];
+            return diff == 0 && Overflow == other.Overflow;
+        }
+
+        /// <summary>
+        /// If this mask includes all ids of the other mask.
+        /// </summary>
+        bool IsSupersetOf(const Self_t& other)const
+        {
+            Word_t missing = 0;
+            for (Size_t i = 0; i < WordCount; ++i)
+                missing |= other.Words[i] & ~Words[i];
+            if (missing != 0)
+                return false;
+            return other.Overflow.empty() || std::includes(Overflow.begin(), Overflow.end(), other.Overflow.begin(), other.Overflow.end());
+        }
+
+        /// <summary>
+        /// If all ids of this mask are included in the other mask.
+        /// </summary>
+        bool IsSubsetOf(const Self_t& other)const
+        {
+            return other.IsSupersetOf(*this);
+        }
+
+        /// <summary>
+        /// If both masks have at least one id in common.
+        /// </summary>
+        bool Intersects(const Self_t& other)const
+        {
+            Word_t common = 0;
+            for (Size_t i = 0; i < WordCount; ++i)
+                common |= Words[i] & other.Words[i];
+            if (common != 0)
+                return true;
+            if (Overflow.empty() || other.Overflow.empty())
+                return false;
+            auto a = Overflow.begin();
+            auto b = other.Overflow.begin();
+            while (a != Overflow.end() && b != other.Overflow.end())
+            {
+                if (*a == *b)
+                    return true;
+                if (*a < *b)
+                    ++a;
+                else
+                    ++b;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Add all ids of the other mask to this mask.
+        /// </summary>
+        Self_t& operator|=(const Self_t& other)
+        {
+            for (Size_t i = 0; i < WordCount; ++i)
+                Words[i] |= other.Words[i];
+            for (const Size_t id : other.Overflow)
+                Set(id);
+            return *this;
+        }
+
+        std::size_t GetHash()const
+        {
+            std::size_t h = 0;
+            for (Size_t i = 0; i < WordCount; ++i)
+                h ^= std::hash<Word_t>()(Words[i]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            for (const Size_t id : Overflow)
+                h ^= std::hash<Size_t>()(id) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+
+        /// <summary>
+        /// Add the id of a component type to the mask.
+        /// </summary>
+        template<typename T>
+        void Set()
+        {
+            Set(ComponentTypeIdT<Size_t>::template Get<T>());
+        }
+
+        template<typename T>
+        bool Test()const
+        {
+            return Test(ComponentTypeIdT<Size_t>::template Get<T>());
+        }
+    };
+}
@@ -256,6 +256,111 @@ namespace NiT
         static FnDataSwap<Size_t> GetBackward() { return &SwapBackward; }
     };
 
+    ////////////////////////////////////////////////////////////////////////////////
+    /// <summary>
+    /// If a component type can be moved to a new address with a memcpy, without running its destructor on the source.
+    /// Trivially copyable types always are. Most types owning heap memory (TArray, FString, TUniquePtr, ...) also are.
+    /// Opt-in by declaring in the component type:
+    ///     static constexpr bool TriviallyRelocatable = true;
+    /// or by specializing IsTriviallyRelocatable<T> to std::true_type.
+    /// </summary>
+    template<typename T, typename = void>
+    struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+    {
+    };
+    template<typename T>
+    struct IsTriviallyRelocatable<T, std::void_t<decltype(T::TriviallyRelocatable)>> : std::bool_constant<T::TriviallyRelocatable || std::is_trivially_copyable_v<T>>
+    {
+    };
+
+    template<typename TSize, typename T, bool TIsTriviallyRelocatable>
+    struct GetRelocator
+    {
+    public:
+        using Size_t = TSize;
+        static FnDataMove<Size_t> GetForward() { return nullptr; }
+    };
+    template<typename TSize, typename T>
+    struct GetRelocator<TSize, T, false>
+    {
+    public:
+        using Size_t = TSize;
+        static void RelocateForward(void* const baseTo, const TSize firstIndexTo, void* const baseFrom, const TSize firstIndexFrom, const TSize count)
+        {
+            T* pTo = (T*)baseTo + firstIndexTo;
+            T* pFrom = (T*)baseFrom + firstIndexFrom;
+            for (Size_t i = 0; i < count; ++i)
+            {
+                new(pTo + i) T(std::move(*(pFrom + i)));
+                (pFrom + i)->~T();
+            }
+        }
+        static FnDataMove<Size_t> GetForward() { return &RelocateForward; }
+    };
+
+    /// <summary>
+    /// Assign a dense integer id to each component type_info, starting at 0 in order of first use.
+    /// Ids are shared by all ComponentTypes of the same type and can index flat tables.
+    /// </summary>
+    template<typename TSize>
+    struct ComponentTypeIdT
+    {
+    public:
+        using Self_t = ComponentTypeIdT<TSize>;
+        using Size_t = TSize;
+
+    private:
+        struct Ids
+        {
+            std::mutex Mutex;
+            std_unordered_map<const type_info*, Size_t> TypeToId;
+        };
+
+    public:
+        /// <summary>
+        /// Get the id of a type_info, assigning the next id on first use.
+        /// </summary>
+        static Size_t Get(const type_info* const type)
+        {
+            Ids& ids = GetIds();
+            std::lock_guard<std::mutex> lock(ids.Mutex);
+            auto i = ids.TypeToId.find(type);
+            if (i != ids.TypeToId.end())
+                return i->second;
+            const Size_t id = (Size_t)ids.TypeToId.size();
+            ids.TypeToId.insert({ type, id });
+            return id;
+        }
+
+        /// <summary>
+        /// Get the id of a component type. Resolved once per type, then a single static load.
+        /// </summary>
+        template<typename T>
+        static Size_t Get()
+        {
+            static const Size_t id = Get(&typeid(std::remove_cv_t<T>));
+            return id;
+        }
+
+        /// <summary>
+        /// Get the number of ids assigned so far. All ids are less than this count.
+        /// </summary>
+        static Size_t GetCount()
+        {
+            Ids& ids = GetIds();
+            std::lock_guard<std::mutex> lock(ids.Mutex);
+            return (Size_t)ids.TypeToId.size();
+        }
+
+    private:
+        static Ids& GetIds()
+        {
+            // Never destroyed, component types may be created or destroyed during static destruction.
+            static Ids* const ids = new Ids();
+            return *ids;
+        }
+    };
+
     /// <summary>
     /// Provide a way to uniquely identify each component types, their owner and how to allocate component memory on demand.
     /// </summary>
@@ -268,6 +373,7 @@ namespace NiT
 
     protected:
         const type_info* TypeInfo;
+        Size_t Id;
         Size_t Size;
         Size_t Align;
         ComponentOwner Owner;
@@ -284,6 +390,18 @@ namespace NiT
         FnDataCopy<Size_t> NonTrivialCopyAssignBackward;
         FnDataSwap<Size_t> NonTrivialSwapForward;
         FnDataSwap<Size_t> NonTrivialSwapBackward;
+        FnDataMove<Size_t> NonTrivialRelocateForward;
+        bool TriviallyDefaultConstructible;
+        bool TriviallyDestructible;
+        bool TriviallyCopyable;
+
+    public:
+#ifdef NI_MEMORY_STATS
+        /// <summary>
+        /// Memory allocated for this component type's data in all chunks.
+        /// </summary>
+        mutable MemoryStats Memory;
+#endif
 
     public:
         /// <summary>
@@ -295,9 +413,26 @@ namespace NiT
         /// <param name="owner">Owner of this component type.</param>
         ComponentTypeT(const std::type_info* const typeInfo, const Size_t size, const Size_t align, const ComponentOwner owner)
             : TypeInfo(typeInfo)
+            , Id(ComponentTypeIdT<Size_t>::Get(typeInfo))
             , Size(size)
             , Align(align)
             , Owner(owner) 
+            , NonTrivialConstruct(nullptr)
+            , NonTrivialDestruct(nullptr)
+            , NonTrivialMoveConstructForward(nullptr)
+            , NonTrivialMoveConstructBackward(nullptr)
+            , NonTrivialMoveAssignForward(nullptr)
+            , NonTrivialMoveAssignBackward(nullptr)
+            , NonTrivialCopyConstructForward(nullptr)
+            , NonTrivialCopyConstructBackward(nullptr)
+            , NonTrivialCopyAssignForward(nullptr)
+            , NonTrivialCopyAssignBackward(nullptr)
+            , NonTrivialSwapForward(nullptr)
+            , NonTrivialSwapBackward(nullptr)
+            , NonTrivialRelocateForward(nullptr)
+            , TriviallyDefaultConstructible(true)
+            , TriviallyDestructible(true)
+            , TriviallyCopyable(true)
         {
             ni_assert(TypeInfo != nullptr);
             ni_assert(Size > 0);
@@ -314,6 +449,7 @@ namespace NiT
         template<typename T>
         ComponentTypeT(const T* const _nullptr, const ComponentOwner owner = T::Owner)
             : TypeInfo(&typeid(T))
+            , Id(ComponentTypeIdT<Size_t>::template Get<T>())
             , Size(sizeof(T))
             , Align(alignof(T))
             , Owner(owner)
@@ -333,6 +469,10 @@ namespace NiT
             NonTrivialCopyAssignForward = GetCopyAssignment<Size_t, T, std::is_copy_assignable_v<T>>::GetBackward();
             NonTrivialSwapForward = GetSwapper<Size_t, T, std::is_swappable<T>::value>::GetForward();
             NonTrivialSwapBackward = GetSwapper<Size_t, T, std::is_swappable<T>::value>::GetBackward();
+            NonTrivialRelocateForward = GetRelocator<Size_t, T, IsTriviallyRelocatable<T>::value || !std::is_move_constructible_v<T>>::GetForward();
+            TriviallyDefaultConstructible = std::is_trivially_default_constructible_v<T>;
+            TriviallyDestructible = std::is_trivially_destructible_v<T>;
+            TriviallyCopyable = std::is_trivially_copyable_v<T>;
         }
 
     public:
@@ -343,6 +483,11 @@ namespace NiT
         ComponentOwner GetOwner()const { return Owner; }
         const type_info* GetTypeInfo()const { return TypeInfo; }
 
+        /// <summary>
+        /// Dense id of the component type, see ComponentTypeIdT.
+        /// </summary>
+        Size_t GetId()const { return Id; }
+
         bool IsNodeComponent()const { return Owner == ComponentOwner::Node; }
         bool IsChunkComponent()const { return Owner == ComponentOwner::Chunk; }
         bool IsNonTrivialConstruct()const { return !!NonTrivialConstruct; }
@@ -352,6 +497,21 @@ namespace NiT
         bool IsNonTrivialCopyConstruct()const { return !!NonTrivialCopyConstructForward; }
         bool IsNonTrivialCopyAssignment()const { return !!NonTrivialCopyAssignForward; }
         bool IsNonTrivialSwap()const { return !!NonTrivialSwapForward; }
+        bool IsNonTrivialRelocate()const { return !!NonTrivialRelocateForward; }
+
+        /// <summary>
+        /// If default constructing the component is the same as zeroing its memory.
+        /// Component types created from a type_info are only raw data and always are.
+        /// </summary>
+        bool IsTriviallyDefaultConstructible()const { return TriviallyDefaultConstructible; }
+        bool IsTriviallyDestructible()const { return TriviallyDestructible; }
+        bool IsTriviallyCopyable()const { return TriviallyCopyable; }
+
+        FnDataProcessor<Size_t> GetNonTrivialConstruct()const { return NonTrivialConstruct; }
+        FnDataProcessor<Size_t> GetNonTrivialDestruct()const { return NonTrivialDestruct; }
+        FnDataMove<Size_t> GetNonTrivialMoveConstructForward()const { return NonTrivialMoveConstructForward; }
+        FnDataCopy<Size_t> GetNonTrivialCopyConstructForward()const { return NonTrivialCopyConstructForward; }
+        FnDataMove<Size_t> GetNonTrivialRelocateForward()const { return NonTrivialRelocateForward; }
 
         /// <summary>
         /// Construct array of component (can be either NodeComponent or ChunkComponent)
@@ -455,6 +615,48 @@ namespace NiT
                                                                   GetComponentCount(nodeCount,          chunkCount));
         }
 
+        /// <summary>
+        /// Relocate components between 2 arrays: move-construct them in baseDataTo and destruct them in baseDataFrom.
+        /// Trivially relocatable components are moved with a single memmove without running any destructor.
+        /// Notes:
+        ///     baseDataTo and baseDataFrom CAN be the same but must not overlap forward.
+        ///     Components in baseDataFrom must be considered destructed afterward.
+        /// </summary>
+        void RelocateDataForwardUnsafe(void* const baseDataTo,   const Size_t firstComponentIndexTo,
+                                       void* const baseDataFrom, const Size_t firstComponentIndexFrom,
+                                       const Size_t count) const
+        {
+            ni_assert(!!baseDataTo);
+            ni_assert(!!baseDataFrom);
+            ni_assert(firstComponentIndexTo >= 0);
+            ni_assert(firstComponentIndexFrom >= 0);
+            ni_assert(count >= 0);
+            ni_assert(!IsOverlappingForward(baseDataTo, firstComponentIndexTo, baseDataFrom, firstComponentIndexFrom, count));
+            ni_assert_owns(baseDataTo,   (firstComponentIndexTo   + count) * Size);
+            ni_assert_owns(baseDataFrom, (firstComponentIndexFrom + count) * Size);
+
+            if (IsNonTrivialRelocate())
+                NonTrivialRelocateForward(baseDataTo, firstComponentIndexTo, baseDataFrom, firstComponentIndexFrom, count);
+            else
+                std::memmove((uint8*)baseDataTo + firstComponentIndexTo * Size, (uint8*)baseDataFrom + firstComponentIndexFrom * Size, count * Size);
+        }
+
+        /// <summary>
+        /// Relocate components between 2 arrays using either node or chunk props depending on the component owner.
+        /// Notes:
+        ///     baseDataTo and baseDataFrom CAN be the same but must not overlap forward.
+        ///     Components in baseDataFrom must be considered destructed afterward.
+        /// </summary>
+        void RelocateComponentForwardUnsafe(
+                void* const baseDataTo,   const            Size_t  firstNodeIndexTo,   const             Size_t  firstChunkIndexTo,
+                void* const baseDataFrom, const            Size_t  firstNodeIndexFrom, const             Size_t  firstChunkIndexFrom,
+                                          const NodeCountT<Size_t> nodeCount,          const ChunkCountT<Size_t> chunkCount)const
+        {
+            RelocateDataForwardUnsafe(baseDataTo,   GetComponentIndex(firstNodeIndexTo,   firstChunkIndexTo),
+                                      baseDataFrom, GetComponentIndex(firstNodeIndexFrom, firstChunkIndexFrom),
+                                                    GetComponentCount(nodeCount,          chunkCount));
+        }
+
         /// <summary>
         /// Move-Assign components between 2 arrays
         /// Notes:
@@ -538,7 +740,85 @@ namespace NiT
                                            baseDataFrom, GetComponentIndex(firstNodeIndexFrom, firstChunkIndexFrom),
                                                          GetComponentCount(nodeCount,          chunkCount));
         }
-        
+
+        /// <summary>
+        /// Copy-Construct count components from an external array, ex.: a loaded or received buffer.
+        /// Trivially copyable components are copied with a single memcpy.
+        /// Notes:
+        ///     source does not need to be owned by the MemoryTracker but must not overlap baseDataTo.
+        /// </summary>
+        void CopyConstructDataFromUnsafe(void* const baseDataTo, const Size_t firstComponentIndexTo,
+                                   const void* const source,     const Size_t count)const
+        {
+            ni_assert(!!baseDataTo);
+            ni_assert(!!source);
+            ni_assert(firstComponentIndexTo >= 0);
+            ni_assert(count >= 0);
+            ni_assert_owns(baseDataTo, (firstComponentIndexTo + count) * Size);
+            ni_assertf(IsTriviallyCopyable() || IsNonTrivialCopyConstruct(), TEXT("Component type is not copy constructible."));
+
+            if (IsTriviallyCopyable())
+                std::memcpy((uint8*)baseDataTo + firstComponentIndexTo * Size, source, count * Size);
+            else
+                NonTrivialCopyConstructForward(baseDataTo, firstComponentIndexTo, source, 0, count);
+        }
+
+        /// <summary>
+        /// Copy-Construct count components from an external array of structures, the component of element i
+        /// being at (source + i * sourceStride).
+        /// Notes:
+        ///     source does not need to be owned by the MemoryTracker but must not overlap baseDataTo.
+        ///     Components that are not trivially copyable must be aligned in the source.
+        /// </summary>
+        void CopyConstructDataStridedFromUnsafe(void* const baseDataTo,   const Size_t firstComponentIndexTo,
+                                          const void* const source,       const Size_t sourceStride,
+                                                                          const Size_t count)const
+        {
+            ni_assert(!!baseDataTo);
+            ni_assert(!!source);
+            ni_assert(firstComponentIndexTo >= 0);
+            ni_assert(sourceStride >= Size);
+            ni_assert(count >= 0);
+            ni_assert_owns(baseDataTo, (firstComponentIndexTo + count) * Size);
+            ni_assertf(IsTriviallyCopyable() || IsNonTrivialCopyConstruct(), TEXT("Component type is not copy constructible."));
+
+            uint8* to = (uint8*)baseDataTo + firstComponentIndexTo * Size;
+            const uint8* from = (const uint8*)source;
+            if (IsTriviallyCopyable())
+            {
+                for (Size_t i = 0; i < count; ++i, to += Size, from += sourceStride)
+                    std::memcpy(to, from, Size);
+            }
+            else
+            {
+                for (Size_t i = 0; i < count; ++i, from += sourceStride)
+                    NonTrivialCopyConstructForward(baseDataTo, firstComponentIndexTo + i, from, 0, 1);
+            }
+        }
+
+        /// <summary>
+        /// Move-Construct count components from an external array, ex.: a loaded or received buffer.
+        /// Trivially copyable components are copied with a single memcpy.
+        /// Notes:
+        ///     source does not need to be owned by the MemoryTracker but must not overlap baseDataTo.
+        ///     Components in source are left moved-from and must still be destructed by their owner.
+        /// </summary>
+        void MoveConstructDataFromUnsafe(void* const baseDataTo, const Size_t firstComponentIndexTo,
+                                         void* const source,     const Size_t count)const
+        {
+            ni_assert(!!baseDataTo);
+            ni_assert(!!source);
+            ni_assert(firstComponentIndexTo >= 0);
+            ni_assert(count >= 0);
+            ni_assert_owns(baseDataTo, (firstComponentIndexTo + count) * Size);
+            ni_assertf(IsTriviallyCopyable() || IsNonTrivialMoveConstruct(), TEXT("Component type is not move constructible."));
+
+            if (IsTriviallyCopyable())
+                std::memcpy((uint8*)baseDataTo + firstComponentIndexTo * Size, source, count * Size);
+            else
+                NonTrivialMoveConstructForward(baseDataTo, firstComponentIndexTo, source, 0, count);
+        }
+
         /// <summary>
         /// Copy-Assign components between 2 arrays.
         /// Notes:
@@ -4,6 +4,7 @@
 #pragma once
 #include "common.h"
 #include "ComponentType.h"
+#include "ComponentMask.h"
 
 namespace NiT
 {
@@ -18,12 +19,23 @@ namespace NiT
         using Self_t = ComponentTypeSetT<TSize>;
         using Size_t = TSize;
         using ComponentType_t = ComponentTypeT<Size_t>;
+        using ComponentMask_t = ComponentMaskT<Size_t>;
 
     private:
         std::size_t Hash;
         std_vector<const ComponentType_t*> ComponentTypes;
         std_unordered_map<const type_info*, Size_t> TypeToComponentTypeIndexInChunk;
 
+        /// <summary>
+        /// Index in the set of each component type id, or -1. Sized to the greatest id in the set.
+        /// </summary>
+        std_vector<Size_t> IdToComponentTypeIndexInChunk;
+
+        /// <summary>
+        /// Bitmask of the ids of all component types in the set.
+        /// </summary>
+        ComponentMask_t Mask;
+
     public:
 
         std::size_t GetHash()const
@@ -50,6 +62,8 @@ namespace NiT
             : Hash(0)
             , ComponentTypes()
             , TypeToComponentTypeIndexInChunk()
+            , IdToComponentTypeIndexInChunk()
+            , Mask()
         {
         }
 
@@ -167,9 +181,52 @@ namespace NiT
         }
         Size_t GetComponentTypeIndexInChunk(const ComponentType_t*const type)const
         {
-            return GetComponentTypeIndexInChunk(type->GetTypeInfo());
+            return GetComponentTypeIndexInChunkById(type->GetId());
+        }
+
+        /// <summary>
+        /// Get the index of a component type id in the set with a single array load.
+        /// Will return -1 if the component type is not present in the set.
+        /// </summary>
+        Size_t GetComponentTypeIndexInChunkById(const Size_t id)const
+        {
+            if (id >= (Size_t)IdToComponentTypeIndexInChunk.size())
+                return -1;
+            return IdToComponentTypeIndexInChunk[id];
+        }
+
+        /// <summary>
+        /// Get the index of a component type in the set, or -1 if not present.
+        /// </summary>
+        template<typename T>
+        Size_t GetComponentTypeIndexInChunk()const
+        {
+            return GetComponentTypeIndexInChunkById(ComponentTypeIdT<Size_t>::template Get<T>());
         }
 
+        /// <summary>
+        /// Get the bitmask of the ids of all component types in the set.
+        /// </summary>
+        const ComponentMask_t& GetMask()const { return Mask; }
+
+        /// <summary>
+        /// If this set includes all component types of the other set.
+        /// </summary>
+        bool IsSupersetOf(const Self_t& other)const { return Mask.IsSupersetOf(other.Mask); }
+        bool IsSupersetOf(const ComponentMask_t& mask)const { return Mask.IsSupersetOf(mask); }
+
+        /// <summary>
+        /// If all component types of this set are included in the other set.
+        /// </summary>
+        bool IsSubsetOf(const Self_t& other)const { return Mask.IsSubsetOf(other.Mask); }
+        bool IsSubsetOf(const ComponentMask_t& mask)const { return Mask.IsSubsetOf(mask); }
+
+        /// <summary>
+        /// If both sets have at least one component type in common.
+        /// </summary>
+        bool Intersects(const Self_t& other)const { return Mask.Intersects(other.Mask); }
+        bool Intersects(const ComponentMask_t& mask)const { return Mask.Intersects(mask); }
+
         template<typename TPredicate>
         void SubSet(Self_t* const resultMemory, TPredicate predicate)
         {
@@ -219,6 +276,15 @@ namespace NiT
             {
                 TypeToComponentTypeIndexInChunk[ComponentTypes[i]->GetTypeInfo()] = i;
             }
+            Size_t idCount = 0;
+            for (const ComponentType_t* componentType : ComponentTypes)
+                idCount = std::max(idCount, componentType->GetId() + 1);
+            IdToComponentTypeIndexInChunk.assign(idCount, -1);
+            for (int i = 0; i < ComponentTypes.size(); ++i)
+                IdToComponentTypeIndexInChunk[ComponentTypes[i]->GetId()] = i;
+            Mask.Clear();
+            for (const ComponentType_t* componentType : ComponentTypes)
+                Mask.Set(componentType->GetId());
             Hash = InternalHasher_t()(*this);
         }
     };
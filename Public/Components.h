@@ -105,4 +105,84 @@ namespace NiT
         /// </summary>
         Size_t Count;
     };
+
+    /// <summary>
+    /// Global monotonic version counter used to stamp component data writes and algorithm runs.
+    /// Each algorithm run takes a new version, writes are stamped with it and an algorithm
+    /// compares the stamps against the version of its own last committed run.
+    /// </summary>
+    struct ChangeVersion
+    {
+    public:
+        /// <summary>
+        /// Take a new version, newer than all versions taken before.
+        /// </summary>
+        static uint32 Increment() { return GetCounter().fetch_add(1, std::memory_order_relaxed) + 1; }
+
+        static uint32 GetCurrent() { return GetCounter().load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Test if version was taken after sinceVersion, wrapping around safely.
+        /// </summary>
+        static bool IsNewer(const uint32 version, const uint32 sinceVersion) { return (int32)(version - sinceVersion) > 0; }
+
+    private:
+        static std::atomic<uint32>& GetCounter()
+        {
+            static std::atomic<uint32> counter(0);
+            return counter;
+        }
+    };
+
+    /// <summary>
+    /// Add to a ChunkStructure to track, per component column, the ChangeVersion of the last algorithm 
+    /// run that requested write access (non-const component pointer) to the column in this chunk.
+    /// Algorithms declaring Changed filters in their Requirements skip the chunk until a filtered column is written.
+    /// Chunks without this component always pass Changed filters.
+    /// </summary>
+    template< typename TSize>
+    struct CoChangeVersionT : public ChunkComponent
+    {
+    public:
+        using Self_t = CoChangeVersionT<TSize>;
+        using Base_t = ChunkComponent;
+        using Size_t = TSize;
+
+    public:
+        /// <summary>
+        /// Version of the last write, per component type index in the ChunkStructure.
+        /// Components at an index of NI_CHANGE_VERSION_CAPACITY or more are never tracked and always considered changed.
+        /// </summary>
+        uint32 Versions[NI_CHANGE_VERSION_CAPACITY];
+
+    public:
+        /// <summary>
+        /// A new chunk has all its columns changed.
+        /// </summary>
+        CoChangeVersionT()
+        {
+            std::fill(std::begin(Versions), std::end(Versions), ChangeVersion::Increment());
+        }
+
+        bool IsChanged(const Size_t componentTypeIndexInChunk, const uint32 sinceVersion)const
+        {
+            if (componentTypeIndexInChunk >= NI_CHANGE_VERSION_CAPACITY)
+                return true;
+            return ChangeVersion::IsNewer(Versions[componentTypeIndexInChunk], sinceVersion);
+        }
+
+        void SetChanged(const Size_t componentTypeIndexInChunk, const uint32 version)
+        {
+            if (componentTypeIndexInChunk < NI_CHANGE_VERSION_CAPACITY)
+                Versions[componentTypeIndexInChunk] = version;
+        }
+
+        /// <summary>
+        /// Set all columns changed, when nodes are added, removed or moved in the chunk.
+        /// </summary>
+        void SetAllChanged(const uint32 version)
+        {
+            std::fill(std::begin(Versions), std::end(Versions), version);
+        }
+    };
 }
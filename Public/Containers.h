@@ -31,6 +31,7 @@
 #include "DBucket.h"
 #include "DBunchPointer.h"
 #include "DBunch.h"
+#include "DPaged.h"
 
 #include "DArrayPointer.h"
 #include "DArray.h"
@@ -117,6 +118,15 @@ namespace NiT
               DOwn<
               BunchPointerT<TChunkStructure>>>;
 
+    // Paged
+    //  ---------   ---------   ---------
+    // |#|#|#|#|#| |#|#|#|#|#| |#|#| | | |...
+    //  ---------   ---------   ---------
+    template<typename TChunkStructure>
+    using PagedT = 
+              DPaged<
+              BucketT<TChunkStructure>>;
+
     // Array
     //  -----------------------------------
     // |-----------|-----------------|-----|
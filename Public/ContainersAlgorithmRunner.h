@@ -10,6 +10,7 @@
 #include "AlgorithmRunnerChunk.h"
 #include "AlgorithmRunnerChunkArray.h"
 #include "AlgorithmRunnerKindPointerSwitch.h"
+#include "AlgorithmRunnerPaged.h"
 
 namespace NiT
 {
@@ -26,8 +27,13 @@ namespace NiT
     template<typename TA, typename TAExt,  typename TBase> struct AlgorithmRunner<TA, DArrayPointer< TAExt,  TBase>> : public AlgorithmRunnerSelector<TA, DArrayPointer< TAExt,  TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
     template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DArray<                TBase>> : public AlgorithmRunnerSelector<TA, DArray<                TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
     template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DUniformArray<         TBase>> : public AlgorithmRunnerSelector<TA, DUniformArray<         TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
+    template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DBarrelPointer<        TBase>> : public AlgorithmRunnerSelector<TA, DBarrelPointer<        TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
+    template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DBarrel<               TBase>> : public AlgorithmRunnerSelector<TA, DBarrel<               TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
+    template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DCarryPointer<         TBase>> : public AlgorithmRunnerSelector<TA, DCarryPointer<         TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
+    template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DCarry<                TBase>> : public AlgorithmRunnerSelector<TA, DCarry<                TBase>, true,  true,  ContainerHasDecorator<TBase, DKind>() > {};
     template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DKind<                 TBase>> : public AlgorithmRunnerSelector<TA, DKind<                 TBase>, true,  true,  true > {};
     template<typename TA,                  typename TBase> struct AlgorithmRunner<TA, DTreePointer<          TBase>> : public AlgorithmRunnerSelector<TA, DTreePointer<          TBase>, true,  true,  true > {};
+    template<typename TA,                  typename TPage> struct AlgorithmRunner<TA, DPaged<                TPage>> : public AlgorithmRunnerPaged<TA, DPaged<TPage>> {};
 
     //                                                                                             Chunk, Array, Kind
     template<typename TA, typename TC                    > struct AlgorithmRunnerSelector< TA, TC, true , false, false> : AlgorithmRunnerChunk<TC> {};
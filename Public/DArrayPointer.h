@@ -79,9 +79,21 @@ namespace NiT
         const ArrayExtension_t& GetArrayExtension()const { return Array; }
               ArrayExtension_t& GetArrayExtension()      { return Array; }
 
+        /// <summary>
+        /// Number of chunks a ComponentDataArray holds void* for: ChunkCapacity, but at least 1 since the first
+        /// void* of each component point to the component data even when ChunkCapacity is 0.
+        /// </summary>
+        static Size_t GetComponentDataArrayChunkCount(const ChunkCapacityT<Size_t> chunkCapacity)
+        {
+            return std::max<Size_t>(chunkCapacity, 1);
+        }
+
         /// <summary>
         /// Set a container's ComponentDataArray to an allocated array of void* large enough to fit one per component per chunk (ChunkCapacity) in the container.
         /// This array is used to store the nodes and chunks component data pointer as void*.
+        /// Notes:
+        ///     With NI_MEMORY_SINGLE_BLOCK, the void* values of every chunk element point into the single memory block
+        ///     allocated by AllocateConstruct. This array stays a separate allocation since reallocation keeps it.
         /// </summary>
         template<typename TContainer>
         static void AllocateComponentDataArray(TContainer& container)
@@ -89,7 +101,7 @@ namespace NiT
             ni_assert(container.IsStruct());
             typename TContainer::ChunkPointerInternal_t& internalChunk = TContainer::GetInternalChunk(container);
             const ChunkCapacityT<Size_t> chunkCapacity = container.GetChunkCapacity();
-            internalChunk.ComponentDataArray = (void**)ni_alloc(chunkCapacity * internalChunk.Structure->Components.GetSize() * sizeof(void*), alignof(void*));
+            internalChunk.ComponentDataArray = (void**)ni_alloc(GetComponentDataArrayChunkCount(chunkCapacity) * internalChunk.Structure->Components.GetSize() * sizeof(void*), alignof(void*));
         }
 
         /// <summary>
@@ -101,7 +113,7 @@ namespace NiT
             ni_assert(container.IsStruct());
             typename TContainer::ChunkPointerInternal_t& internalChunk = TContainer::GetInternalChunk(container);
             ChunkCapacityT<Size_t> chunkCapacity = container.GetChunkCapacity();
-            ni_free_clean(internalChunk.ComponentDataArray, chunkCapacity * internalChunk.Structure->Components.GetSize() * sizeof(void*), alignof(void*));
+            ni_free_clean(internalChunk.ComponentDataArray, GetComponentDataArrayChunkCount(chunkCapacity) * internalChunk.Structure->Components.GetSize() * sizeof(void*), alignof(void*));
         }
 
         /// <summary>
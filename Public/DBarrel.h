@@ -6,7 +6,13 @@
 
 namespace NiT
 {
-    //TODO complete
+    /// <summary>
+    /// Container of Chunk, Node and their component data.
+    /// 
+    /// Container with a variable ChunkCount of constructed chunk elements up to a fixed ChunkCapacity, sharing a fixed 
+    /// NodeCapacity (ChunkCapacity * NodeCapacityPerChunk) of allocated nodes.
+    /// Chunk elements are added and removed with AddChunks/RemoveChunks without reallocating.
+    /// </summary>
     template<typename TBase>
     struct DBarrel : public TBase
     {
@@ -20,9 +26,7 @@ namespace NiT
         using typename Base_t::Node_t;
         using typename Base_t::ChunkPointerInternal_t;
         using typename Base_t::ChunkPointer_t;
-        using typename Base_t::Chunk_t;
         using typename Base_t::ArrayExtension_t;
-        using typename Base_t::ChunkPointerInternal_t;
         using typename Base_t::ChunkPointerElementInternal_t;
 
         DBarrel() = default;
@@ -31,53 +35,68 @@ namespace NiT
         {
         }
 
-
         // Full Uniform Barrel
         DBarrel(const ChunkStructure_t* const chunkStructure,
                 const ChunkCountT<       Size_t> chunkCount,
                 const NodeCountPerChunkT<Size_t> nodeCountPerChunk)
-            : Base_t(chunkStructure,
-                     chunkCount,
-                     PropChunkCapacityT<Size_t>(chunkCount),
-                     PropNodeCountT<    Size_t>(chunkCount * nodeCountPerChunk),
-                     PropNodeCapacityT< Size_t>(chunkCount * nodeCountPerChunk),
-                     nodeCountPerChunk)
+            : DBarrel(chunkStructure,
+                      PropCountToCapacity(chunkCount),
+                      nodeCountPerChunk,
+                      chunkCount,
+                      PropCountToCapacity(nodeCountPerChunk))
         {
         }
 
-        // Empty, Partial or Full Uniform array
+        // Empty, Partial or Full Uniform Barrel
         // nodeCountPerChunk may be 0.
         DBarrel(const ChunkStructure_t* const chunkStructure,
                 const ChunkCapacityT<    Size_t> chunkCapacity,
                 const NodeCountPerChunkT<Size_t> nodeCountPerChunk,
                 const ChunkCountT<       Size_t> chunkCount)
+            : DBarrel(chunkStructure,
+                      chunkCapacity,
+                      nodeCountPerChunk,
+                      chunkCount,
+                      PropCountToCapacity(nodeCountPerChunk))
+        {
+        }
+
+        // Empty, Partial or Full Uniform Barrel with additional node capacity per chunk.
+        // nodeCountPerChunk may be 0.
+        // Chunk elements can be added as long as the total NodeCount fits in chunkCapacity * nodeCapacityPerChunk.
+        DBarrel(const ChunkStructure_t* const chunkStructure,
+                const ChunkCapacityT<       Size_t> chunkCapacity,
+                const NodeCountPerChunkT<   Size_t> nodeCountPerChunk,
+                const ChunkCountT<          Size_t> chunkCount,
+                const NodeCapacityPerChunkT<Size_t> nodeCapacityPerChunk)
             : Base_t(chunkStructure,
                      chunkCount,
                      chunkCapacity,
                      PropNodeCountT<   Size_t>(chunkCount *    nodeCountPerChunk),
-                     PropNodeCapacityT<Size_t>(chunkCapacity * nodeCountPerChunk),
-                     nodeCountPerChunk)
+                     PropNodeCapacityT<Size_t>(chunkCapacity * nodeCapacityPerChunk),
+                     nodeCountPerChunk,
+                     nodeCapacityPerChunk)
         {
             ni_assert(chunkCapacity >= 0);
             ni_assert(nodeCountPerChunk >= 0);
             ni_assert(chunkCount >= 0);
             ni_assert(chunkCount <= chunkCapacity);
+            ni_assert(nodeCountPerChunk <= nodeCapacityPerChunk);
         }
 
-        // Empty, Partial or Full Uniform array with additional node capacity.
+        // Empty, Partial or Full Uniform Barrel with a total node capacity.
         // nodeCountPerChunk may be 0.
-        // Chunk elements can increade/decrease node count up to the total node capacity.
+        // nodeCapacity is rounded up to a whole NodeCapacityPerChunk for each of the chunkCapacity chunk elements.
         DBarrel(const ChunkStructure_t* const chunkStructure,
                 const ChunkCapacityT<    Size_t> chunkCapacity,
                 const NodeCountPerChunkT<Size_t> nodeCountPerChunk,
                 const ChunkCountT<       Size_t> chunkCount,
                 const NodeCapacityT<     Size_t> nodeCapacity)
-            : Base_t(chunkStructure,
-                     chunkCount,
-                     chunkCapacity,
-                     PropNodeCountT<Size_t>(chunkCount * nodeCountPerChunk),
-                     nodeCapacity,
-                     nodeCountPerChunk)
+            : DBarrel(chunkStructure,
+                      chunkCapacity,
+                      nodeCountPerChunk,
+                      chunkCount,
+                      Base_t::NodeCapacityPerChunkFor(nodeCapacity, chunkCapacity, nodeCountPerChunk))
         {
         }
     };
@@ -6,7 +6,13 @@
 
 namespace NiT
 {
-    // TODO complete
+    /// <summary>
+    /// Adds a ChunkCapacity and a NodeCapacityPerChunk to an array of chunks, allowing chunk elements to be added and removed.
+    /// Chunk elements stay packed: the nodes of each chunk element follow the nodes of the previous one in the shared component data,
+    /// leaving the unused capacity at the end of the array.
+    /// The total NodeCapacity is ChunkCapacity * NodeCapacityPerChunk and is shared by all chunk elements.
+    /// </summary>
+    /// <typeparam name="TBase"></typeparam>
     template<typename TBase>
     struct DBarrelPointer : public TBase
     {
@@ -63,20 +69,125 @@ namespace NiT
 
 
     public:
-        using Base_t::operator*;
-        using Base_t::operator->;
         using Base_t::operator[];
         using Base_t::GetChunkCount;
         using Base_t::IsSameStructure;
         
+        using Base_t::GetNodeCount;
+        
         Size_t AvailableChunks()const { return ChunkCapacity - GetChunkCount(); }
+        Size_t AvailableNodes()const { return GetNodeCapacity() - GetNodeCount(); }
+
+        /// <summary>
+        /// Add a single chunk element at index ChunkCount with nodeCount constructed nodes and return its index.
+        /// If there is not enough ChunkCapacity or NodeCapacity left, return -1 without adding the chunk element.
+        /// </summary>
+        Size_t AddChunk(const NodeCountT<Size_t> nodeCount)
+        {
+            return AddChunks(ChunkCountT<Size_t>::V_1(), NodeCountPerChunkT<Size_t>((Size_t)nodeCount));
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddChunk(const Size_t nodeCount)
+        {
+            return AddChunk(PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple chunk elements at index ChunkCount, each with nodeCountPerChunk constructed nodes, and return the index of the first chunk element added.
+        /// The nodes of the new chunk elements are added after the last node of the array.
+        /// If there is not enough ChunkCapacity or NodeCapacity left, return -1 without adding any chunk elements.
+        /// </summary>
+        Size_t AddChunks(const ChunkCountT<Size_t> chunkCount, const NodeCountPerChunkT<Size_t> nodeCountPerChunk)
+        {
+            ChunkPointerInternal_t& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            ni_assert(chunkCount >= 0);
+            ni_assert(nodeCountPerChunk >= 0);
+            const NodeCountT<Size_t> nodeCount = chunkCount * nodeCountPerChunk;
+            if (chunkCount > AvailableChunks() || nodeCount > AvailableNodes())
+                return -1;
+
+            const Size_t firstChunkIndex = GetChunkCount();
+            const Size_t firstNodeIndex = internalChunk.NodeCount;
+            Node_t::ConstructAllComponentsUnsafe(internalChunk, firstNodeIndex, nodeCount, firstChunkIndex, chunkCount);
+            internalChunk.NodeCount += nodeCount;
+            this->Array.ChunkCount += chunkCount;
+            for (Size_t i = 0; i < chunkCount; ++i)
+                this->Array.ConstructElement(*this, 
+                          /*elementIndex:*/    firstChunkIndex + i, 
+                          /*firstNodeInArray:*/firstNodeIndex + i * nodeCountPerChunk, 
+                          /*nodeCount:*/       ChunkCountT<Size_t>::V_1() * nodeCountPerChunk);
+            return firstChunkIndex;
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddChunks(const Size_t chunkCount, const Size_t nodeCountPerChunk)
+        {
+            return AddChunks(PropChunkCountT<Size_t>(chunkCount), PropNodeCountPerChunkT<Size_t>(nodeCountPerChunk));
+        }
+#endif
+
+        /// <summary>
+        /// Remove a range of chunk elements with all their nodes and close the gap by moving the following chunk elements and 
+        /// their nodes, preserving the order of chunk elements.
+        /// Removing the last chunk elements does not move any node.
+        /// </summary>
+        void RemoveChunks(const Size_t firstChunkIndex, const ChunkCountT<Size_t> chunkCount = ChunkCountT<Size_t>::V_1())
+        {
+            ChunkPointerInternal_t& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            ni_assert(firstChunkIndex >= 0);
+            ni_assert(chunkCount >= 0);
+            ni_assert(firstChunkIndex + chunkCount <= GetChunkCount());
+
+            const Size_t chunkCountOld = GetChunkCount();
+            const Size_t endChunkIndex = firstChunkIndex + chunkCount;
+            Size_t removedNodeCount = 0;
+            for (Size_t i = firstChunkIndex; i < endChunkIndex; ++i)
+                removedNodeCount += this->Array.Chunks[i].GetNodeCount();
+            Size_t followingNodeCount = 0;
+            for (Size_t i = endChunkIndex; i < chunkCountOld; ++i)
+                followingNodeCount += this->Array.Chunks[i].GetNodeCount();
+            const Size_t firstNodeIndex = internalChunk.NodeCount - followingNodeCount - removedNodeCount;
 
-        // TODO 
-        void AddChunks() {}
-        // TODO
-        void RemoveChunks() {}
-        // TODO
-        void ClearChunks() {}
+            Node_t::DestructAllComponentsUnsafe(internalChunk, firstNodeIndex, firstChunkIndex, PropNodeCountT<Size_t>(removedNodeCount), chunkCount);
+            Node_t::RelocateAllNodeComponentsForwardUnsafe( internalChunk, firstNodeIndex,  internalChunk, firstNodeIndex + removedNodeCount, PropNodeCountT< Size_t>(followingNodeCount));
+            Node_t::RelocateAllChunkComponentsForwardUnsafe(internalChunk, firstChunkIndex, internalChunk, endChunkIndex,                     PropChunkCountT<Size_t>(chunkCountOld - endChunkIndex));
+
+            // Point the following chunk elements to their new first node and chunk index
+            Size_t nodeIndex = firstNodeIndex;
+            for (Size_t i = firstChunkIndex; i < chunkCountOld - chunkCount; ++i)
+            {
+                const NodeCountT<Size_t> elementNodeCount = this->Array.Chunks[i + chunkCount].GetNodeCount();
+                this->Array.Chunks[i].~ChunkPointerElement_t();
+                this->Array.ConstructElement(*this, i, nodeIndex, elementNodeCount);
+                nodeIndex += elementNodeCount;
+            }
+            for (Size_t i = chunkCountOld - chunkCount; i < chunkCountOld; ++i)
+                this->Array.Chunks[i].~ChunkPointerElement_t();
+
+            internalChunk.NodeCount -= removedNodeCount;
+            this->Array.ChunkCount -= chunkCount;
+        }
+#ifndef PNC_PROPS_STRICT
+        void RemoveChunks(const Size_t firstChunkIndex, const Size_t chunkCount)
+        {
+            RemoveChunks(firstChunkIndex, PropChunkCountT<Size_t>(chunkCount));
+        }
+#endif
+
+        /// <summary>
+        /// Destruct all chunk elements and their nodes, keeping the allocated ChunkCapacity and NodeCapacity.
+        /// </summary>
+        void ClearChunks()
+        {
+            ChunkPointerInternal_t& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            Node_t::DestructAllComponentsUnsafe(internalChunk, 0, 0, internalChunk.NodeCount, GetChunkCount());
+            this->Array.Destruct(*this);
+            internalChunk.NodeCount = NodeCountT<Size_t>::V_0();
+            this->Array.ChunkCount = ChunkCountT<Size_t>::V_0();
+        }
 
         /// <summary>
         /// The total maximum number of Nodes the Array can grow to.
@@ -100,6 +211,61 @@ namespace NiT
         using Base_t::GetInternalChunkElement;
 
     protected:
+        /// <summary>
+        /// Get the smallest NodeCapacityPerChunk giving chunkCapacity chunk elements at least nodeCapacity nodes in total,
+        /// and at least nodeCountPerChunk nodes each.
+        /// Used by the constructors taking a total NodeCapacity instead of a NodeCapacityPerChunk.
+        /// </summary>
+        static NodeCapacityPerChunkT<Size_t> NodeCapacityPerChunkFor(const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity, const NodeCountPerChunkT<Size_t> nodeCountPerChunk)
+        {
+            const Size_t nodeCapacityPerChunk = chunkCapacity > 0 ? ((Size_t)nodeCapacity + (Size_t)chunkCapacity - 1) / (Size_t)chunkCapacity : 0;
+            return PropNodeCapacityPerChunkT<Size_t>(std::max<Size_t>(nodeCapacityPerChunk, nodeCountPerChunk));
+        }
+
+        /// <summary>
+        /// Reallocate the component data, the ComponentDataArray and the chunk elements for a new ChunkCapacity and NodeCapacityPerChunk,
+        /// moving all chunk elements and their nodes.
+        /// Notes:
+        ///     chunkCapacity * nodeCapacityPerChunk must be greater or equal to NodeCount.
+        ///     chunkCapacity must be greater or equal to ChunkCount.
+        /// </summary>
+        void ReallocateChunks(const ChunkCapacityT<Size_t> chunkCapacity, const NodeCapacityPerChunkT<Size_t> nodeCapacityPerChunk)
+        {
+            ChunkPointerInternal_t& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            const NodeCapacityT<Size_t> nodeCapacity = chunkCapacity * nodeCapacityPerChunk;
+            const ChunkCountT<Size_t> chunkCount = GetChunkCount();
+            ni_assert(chunkCapacity >= chunkCount);
+            ni_assert(nodeCapacity >= GetNodeCount());
+
+            // Only the first componentCount void* point to the component data, the others are set by each chunk element.
+            // Both arrays hold at least these, even for a ChunkCapacity of 0.
+            const Size_t componentCount = internalChunk.Structure->GetComponentCount();
+            void** const componentDataArrayOld = internalChunk.ComponentDataArray;
+            internalChunk.ComponentDataArray = (void**)ni_alloc(Base_t::GetComponentDataArrayChunkCount(chunkCapacity) * componentCount * sizeof(void*), alignof(void*));
+            std::copy(componentDataArrayOld, componentDataArrayOld + componentCount, internalChunk.ComponentDataArray);
+            ni_free_dirty(componentDataArrayOld, Base_t::GetComponentDataArrayChunkCount(ChunkCapacity) * componentCount * sizeof(void*), alignof(void*));
 
+            Node_t::ReallocateMoveAllComponentsForwardUnsafe(
+                        *this, 0/*:firstNodeIndexTo*/,   0/*:firstChunkIndexTo*/,
+                        *this, 0/*:firstNodeIndexFrom*/, 0/*:firstChunkIndexFrom*/,
+                               nodeCapacity,             chunkCapacity,
+                               GetNodeCount(),           chunkCount);
+
+            ChunkPointerElement_t* const chunksOld = this->Array.Chunks;
+            const ChunkCapacityT<Size_t> chunkCapacityOld = ChunkCapacity;
+            ChunkCapacity = chunkCapacity;
+            NodeCapacityPerChunk = nodeCapacityPerChunk;
+            this->Array.Allocate(*this, chunkCapacity, nodeCapacity);
+            Size_t nodeIndex = 0;
+            for (Size_t i = 0; i < chunkCount; ++i)
+            {
+                const NodeCountT<Size_t> elementNodeCount = chunksOld[i].GetNodeCount();
+                this->Array.ConstructElement(*this, i, nodeIndex, elementNodeCount);
+                nodeIndex += elementNodeCount;
+                chunksOld[i].~ChunkPointerElement_t();
+            }
+            ni_free_dirty(chunksOld, chunkCapacityOld * sizeof(ChunkPointerElement_t), alignof(ChunkPointerElement_t));
+        }
     };
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "common.h"
+#include "NodeHandle.h"
 
 namespace NiT
 {
@@ -22,6 +23,7 @@ namespace NiT
         using typename Base_t::ChunkPointerInternal_t;
         using typename Base_t::ChunkPointer_t;
         using ComponentType_t = typename ChunkStructure_t::ComponentType_t;
+        using NodeHandleTable_t = NodeHandleTableT<ChunkStructure_t>;
 
     protected:
         /// <summary>
@@ -116,6 +118,7 @@ namespace NiT
             {
                 Node_t::ConstructAllNodeComponentsUnsafe(internalChunk, firstIndex, count);
                 internalChunk.NodeCount += count;
+                StampStructuralChange();
                 return firstIndex;
             }
             return -1;
@@ -126,6 +129,90 @@ namespace NiT
             return AddNodes(PropNodeCountT<Size_t>(count)); 
         }
 #endif
+
+        /// <summary>
+        /// Add multiple sequential nodes at index NodeCount, copy constructing their NodeComponents from external arrays,
+        /// and return the index of the first node added. See Node_t::CopyConstructAllNodeComponentsFromUnsafe for componentSources.
+        /// The new nodes have no NodeHandle yet, even if a CoNodeHandle source is given.
+        /// If NodeCount + count > NodeCapacity, return -1 without adding any new nodes.
+        /// </summary>
+        Size_t AddNodesCopy(const void* const* const componentSources, const NodeCountT<Size_t> count)
+        {
+            auto& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            Size_t firstIndex = internalChunk.NodeCount;
+            if (firstIndex + count <= NodeCapacity)
+            {
+                Node_t::CopyConstructAllNodeComponentsFromUnsafe(internalChunk, firstIndex, componentSources, count);
+                NodeHandleTable_t::DetachNodes(*this, firstIndex, count);
+                internalChunk.NodeCount += count;
+                StampStructuralChange();
+                return firstIndex;
+            }
+            return -1;
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodesCopy(const void* const* const componentSources, const Size_t count)
+        {
+            return AddNodesCopy(componentSources, PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple sequential nodes at index NodeCount, move constructing their NodeComponents from external arrays,
+        /// and return the index of the first node added. See Node_t::MoveConstructAllNodeComponentsFromUnsafe for componentSources.
+        /// The new nodes have no NodeHandle yet, even if a CoNodeHandle source is given.
+        /// If NodeCount + count > NodeCapacity, return -1 without adding any new nodes.
+        /// </summary>
+        Size_t AddNodesMove(void* const* const componentSources, const NodeCountT<Size_t> count)
+        {
+            auto& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            Size_t firstIndex = internalChunk.NodeCount;
+            if (firstIndex + count <= NodeCapacity)
+            {
+                Node_t::MoveConstructAllNodeComponentsFromUnsafe(internalChunk, firstIndex, componentSources, count);
+                NodeHandleTable_t::DetachNodes(*this, firstIndex, count);
+                internalChunk.NodeCount += count;
+                StampStructuralChange();
+                return firstIndex;
+            }
+            return -1;
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodesMove(void* const* const componentSources, const Size_t count)
+        {
+            return AddNodesMove(componentSources, PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple sequential nodes at index NodeCount, copy constructing their NodeComponents from an external array of structures,
+        /// and return the index of the first node added. See Node_t::CopyConstructAllNodeComponentsStridedFromUnsafe for the arguments.
+        /// The new nodes have no NodeHandle yet, even if a CoNodeHandle source is given.
+        /// If NodeCount + count > NodeCapacity, return -1 without adding any new nodes.
+        /// </summary>
+        Size_t AddNodesCopyStrided(const void* const source, const Size_t sourceStride, const Size_t* const componentOffsets, const NodeCountT<Size_t> count)
+        {
+            auto& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            Size_t firstIndex = internalChunk.NodeCount;
+            if (firstIndex + count <= NodeCapacity)
+            {
+                Node_t::CopyConstructAllNodeComponentsStridedFromUnsafe(internalChunk, firstIndex, source, sourceStride, componentOffsets, count);
+                NodeHandleTable_t::DetachNodes(*this, firstIndex, count);
+                internalChunk.NodeCount += count;
+                StampStructuralChange();
+                return firstIndex;
+            }
+            return -1;
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodesCopyStrided(const void* const source, const Size_t sourceStride, const Size_t* const componentOffsets, const Size_t count)
+        {
+            return AddNodesCopyStrided(source, sourceStride, componentOffsets, PropNodeCountT<Size_t>(count));
+        }
+#endif
         
         /// <summary>
         /// Remove a range of nodes and close the gap by moving the higher nodes after 
@@ -139,7 +226,10 @@ namespace NiT
             ni_assert(firstNodexIndex + nodeCount <= GetNodeCount());
 
             auto& internalChunk = GetInternalChunk(*this);
+            const bool hasNodeHandles = NodeHandleTable_t::HasNodeHandles(*this);
 
+            if (hasNodeHandles)
+                NodeHandleTable_t::ReleaseNodes(*this, firstNodexIndex, nodeCount);
             Node_t::DestructAllNodeComponentsUnsafe(internalChunk, firstNodexIndex, nodeCount);
 
             const auto firstMovingNodeIndex = internalChunk.NodeCount - nodeCount;
@@ -147,13 +237,16 @@ namespace NiT
             if(firstFollowingNodeIndex < internalChunk.NodeCount)
             {
                 const auto followingNodeCount = internalChunk.NodeCount - firstFollowingNodeIndex;
-                Node_t::MoveAllNodeComponentsForwardUnsafe(internalChunk, firstNodexIndex,
-                                                           internalChunk, firstFollowingNodeIndex,
-                                                                          followingNodeCount);
+                Node_t::RelocateAllNodeComponentsForwardUnsafe(internalChunk, firstNodexIndex,
+                                                               internalChunk, firstFollowingNodeIndex,
+                                                                              followingNodeCount);
                 internalChunk.NodeCount = PropNodeCountT<Size_t>(firstNodexIndex + followingNodeCount);
+                if (hasNodeHandles)
+                    NodeHandleTable_t::UpdateNodes(*this, firstNodexIndex, followingNodeCount);
             }
             else
                 internalChunk.NodeCount = PropNodeCountT<Size_t>(firstNodexIndex);
+            StampStructuralChange();
         }
 #ifndef PNC_PROPS_STRICT
         void RemoveNodeKeepOrder(const Size_t firstNodexIndex, const Size_t nodeCount = (Size_t)0)
@@ -165,6 +258,7 @@ namespace NiT
         /// <summary>
         /// Remove a range of nodes and close the gap by moving the trailing nodes in 
         /// the gap, which will break the previous ordering of nodes.
+        /// Trailing nodes are relocated: trivially relocatable components are only memmoved.
         /// </summary>
         void RemoveNode(const Size_t firstNodeIndex, const NodeCountT<Size_t> nodeCount = NodeCountT<Size_t>::V_1())
         {
@@ -173,24 +267,142 @@ namespace NiT
             ni_assert(firstNodeIndex < GetNodeCount());
             ni_assert(firstNodeIndex + nodeCount <= GetNodeCount());
 
-            auto& internalChunk = GetInternalChunk(*this);
+            const bool hasNodeHandles = NodeHandleTable_t::HasNodeHandles(*this);
+            if (hasNodeHandles)
+                NodeHandleTable_t::ReleaseNodes(*this, firstNodeIndex, nodeCount);
+            Node_t::DestructAllNodeComponentsUnsafe(GetInternalChunk(*this), firstNodeIndex, nodeCount);
+            RemoveDestructedNodesUnsafe(firstNodeIndex, nodeCount, hasNodeHandles);
+        }
+#ifndef PNC_PROPS_STRICT
+        void RemoveNode(const Size_t firstNodexIndex, const Size_t nodeCount = (Size_t)1)
+        {
+            RemoveNode(firstNodexIndex, PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+        /// <summary>
+        /// Remove a range of nodes already destructed or relocated elsewhere and close the gap the same way RemoveNode does.
+        /// Notes:
+        ///     Components of the nodes in the range must not be accessed anymore, making this function unsafe.
+        /// </summary>
+        void RemoveDestructedNodesUnsafe(const Size_t firstNodeIndex, const NodeCountT<Size_t> nodeCount)
+        {
+            RemoveDestructedNodesUnsafe(firstNodeIndex, nodeCount, NodeHandleTable_t::HasNodeHandles(*this));
+        }
 
-            Node_t::DestructAllNodeComponentsUnsafe(internalChunk, firstNodeIndex, nodeCount);
+    protected:
+        void RemoveDestructedNodesUnsafe(const Size_t firstNodeIndex, const NodeCountT<Size_t> nodeCount, const bool hasNodeHandles)
+        {
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(firstNodeIndex + nodeCount <= GetNodeCount());
+
+            auto& internalChunk = GetInternalChunk(*this);
             const auto lastNodexIndex = firstNodeIndex + nodeCount;
             const auto movingFirstNodeIndex = std::max<Size_t>(lastNodexIndex, internalChunk.NodeCount - nodeCount);
             const auto movingNodeCount = internalChunk.NodeCount - movingFirstNodeIndex;
             if(movingNodeCount > 0)
             {
-                Node_t::MoveAllNodeComponentsForwardUnsafe(internalChunk, firstNodeIndex,
-                                                           internalChunk, movingFirstNodeIndex,
-                                                                          movingNodeCount);
+                Node_t::RelocateAllNodeComponentsForwardUnsafe(internalChunk, firstNodeIndex,
+                                                               internalChunk, movingFirstNodeIndex,
+                                                                              movingNodeCount);
             }
             internalChunk.NodeCount -= nodeCount;
+            if (hasNodeHandles && movingNodeCount > 0)
+                NodeHandleTable_t::UpdateNodes(*this, firstNodeIndex, movingNodeCount);
+            StampStructuralChange();
+        }
+
+    public:
+
+        /// <summary>
+        /// Remove a set of nodes given by unsorted node indices and close the gaps by moving the trailing nodes in
+        /// them, which will break the previous ordering of nodes.
+        /// All removed nodes are destructed first, then each NodeComponent column is compacted in a single pass.
+        /// Notes:
+        ///     nodeIndices must not contain duplicates.
+        /// </summary>
+        void RemoveNodes(const Size_t* const nodeIndices, const NodeCountT<Size_t> nodeCount)
+        {
+            RemoveSortedNodes(SortNodeIndices(nodeIndices, nodeCount), false);
         }
 #ifndef PNC_PROPS_STRICT
-        void RemoveNode(const Size_t firstNodexIndex, const Size_t nodeCount = (Size_t)1)
+        void RemoveNodes(const Size_t* const nodeIndices, const Size_t nodeCount)
         {
-            RemoveNode(firstNodexIndex, PropNodeCountT<Size_t>(nodeCount));
+            RemoveNodes(nodeIndices, PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+        /// <summary>
+        /// Remove a set of nodes given by unsorted node indices and close the gaps by moving the higher nodes
+        /// after the lower nodes, preserving the order of nodes.
+        /// All removed nodes are destructed first, then each NodeComponent column is compacted in a single pass.
+        /// Notes:
+        ///     nodeIndices must not contain duplicates.
+        /// </summary>
+        void RemoveNodesKeepOrder(const Size_t* const nodeIndices, const NodeCountT<Size_t> nodeCount)
+        {
+            RemoveSortedNodes(SortNodeIndices(nodeIndices, nodeCount), true);
+        }
+#ifndef PNC_PROPS_STRICT
+        void RemoveNodesKeepOrder(const Size_t* const nodeIndices, const Size_t nodeCount)
+        {
+            RemoveNodesKeepOrder(nodeIndices, PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+        /// <summary>
+        /// Remove all nodes with their bit set in removeMask the same way RemoveNodes does.
+        /// Bit (i % 64) of word (i / 64) is node i, removeMask must hold at least (NodeCount + 63) / 64 words.
+        /// </summary>
+        void RemoveNodes(const uint64* const removeMask)
+        {
+            RemoveSortedNodes(MaskToNodeIndices(removeMask), false);
+        }
+
+        /// <summary>
+        /// Remove all nodes with their bit set in removeMask the same way RemoveNodesKeepOrder does.
+        /// Bit (i % 64) of word (i / 64) is node i, removeMask must hold at least (NodeCount + 63) / 64 words.
+        /// </summary>
+        void RemoveNodesKeepOrder(const uint64* const removeMask)
+        {
+            RemoveSortedNodes(MaskToNodeIndices(removeMask), true);
+        }
+
+        /// <summary>
+        /// Move a range of nodes from another container, of any structure, to the end of this container and return the index of the first node added.
+        /// Components in both structures are relocated, components only in this structure are default constructed and 
+        /// components only in the other structure are destructed. The gap left in containerFrom is closed the same way RemoveNode does.
+        /// If NodeCount + nodeCount > NodeCapacity, return -1 without migrating any node.
+        /// </summary>
+        template<typename TContainerFrom>
+        Size_t MigrateNodes(TContainerFrom& containerFrom, const Size_t firstNodeIndexFrom, const NodeCountT<Size_t> nodeCount)
+        {
+            ni_assert(firstNodeIndexFrom >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(firstNodeIndexFrom + nodeCount <= containerFrom.GetNodeCount());
+            ni_assert((const void*)this != (const void*)&containerFrom);
+
+            auto& internalChunk = GetInternalChunk(*this);
+            ni_assert(!internalChunk.IsNull());
+            const Size_t firstIndex = internalChunk.NodeCount;
+            if (firstIndex + nodeCount > NodeCapacity)
+                return -1;
+            NodeHandleTable_t::PrepareMigration(*this, containerFrom, firstNodeIndexFrom, nodeCount);
+            Node_t::MigrateAllNodeComponentsForwardUnsafe(internalChunk, firstIndex,
+                                                          containerFrom, firstNodeIndexFrom,
+                                                                         nodeCount);
+            internalChunk.NodeCount += nodeCount;
+            NodeHandleTable_t::UpdateNodes(*this, firstIndex, nodeCount);
+            StampStructuralChange();
+            containerFrom.RemoveDestructedNodesUnsafe(firstNodeIndexFrom, nodeCount);
+            return firstIndex;
+        }
+#ifndef PNC_PROPS_STRICT
+        template<typename TContainerFrom>
+        Size_t MigrateNodes(TContainerFrom& containerFrom, const Size_t firstNodeIndexFrom, const Size_t nodeCount)
+        {
+            return MigrateNodes(containerFrom, firstNodeIndexFrom, PropNodeCountT<Size_t>(nodeCount));
         }
 #endif
 
@@ -204,11 +416,28 @@ namespace NiT
         {
             auto& container = GetInternalChunk(*this);
             if (container.IsNull()) return;
+            if (NodeHandleTable_t::HasNodeHandles(*this))
+                NodeHandleTable_t::ReleaseNodes(*this, 0, container.NodeCount);
             Node_t::DestructAllNodeComponentsUnsafe(GetChunk(), 0, container.NodeCount);
             container.NodeCount = NodeCountT<Size_t>::V_0();
+            StampStructuralChange();
         }
 
     protected:
+        /// <summary>
+        /// Stamp all columns with a new ChangeVersion once nodes were added, removed or moved,
+        /// so algorithms with Changed filters see the new, removed or relocated nodes of any column.
+        /// Does nothing if the structure has no CoChangeVersion.
+        /// </summary>
+        void StampStructuralChange()
+        {
+            using CoChangeVersion_t = CoChangeVersionT<Size_t>;
+            auto& internalChunk = GetInternalChunk(*this);
+            const Size_t index = internalChunk.GetStructure().template GetComponentTypeIndexInChunk<CoChangeVersion_t>();
+            if (index >= 0)
+                ((CoChangeVersion_t*)internalChunk.GetComponentData(index))->SetAllChanged(ChangeVersion::Increment());
+        }
+
         /// <summary>
         /// Construct from Props
         /// </summary>
@@ -219,6 +448,111 @@ namespace NiT
         {
         }
 
+        std_vector<Size_t> SortNodeIndices(const Size_t* const nodeIndices, const NodeCountT<Size_t> nodeCount)const
+        {
+            ni_assert(nodeCount >= 0);
+            ni_assert(nodeCount == 0 || !!nodeIndices);
+            std_vector<Size_t> sorted(nodeIndices, nodeIndices + (Size_t)nodeCount);
+            std::sort(sorted.begin(), sorted.end());
+            ni_assertf(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end(), TEXT("Node indices to remove must be unique."));
+            return sorted;
+        }
+
+        std_vector<Size_t> MaskToNodeIndices(const uint64* const removeMask)const
+        {
+            ni_assert(!!removeMask);
+            std_vector<Size_t> sorted;
+            const Size_t nodeCount = GetNodeCount();
+            for (Size_t wordIndex = 0; wordIndex * 64 < nodeCount; ++wordIndex)
+            {
+                uint64 word = removeMask[wordIndex];
+                while (word != 0)
+                {
+                    const Size_t nodeIndex = wordIndex * 64 + (Size_t)std::countr_zero(word);
+                    if (nodeIndex >= nodeCount)
+                        break;
+                    sorted.push_back(nodeIndex);
+                    word &= word - 1;
+                }
+            }
+            return sorted;
+        }
+
+        /// <summary>
+        /// Release and destruct the nodes at sortedNodeIndices, one call per range of sequential indices,
+        /// then relocate the remaining nodes to close the gaps with a single RelocateAllNodeComponentsUnsafe.
+        /// Without keepOrder, gaps below the new NodeCount are filled in order with the trailing nodes not removed.
+        /// </summary>
+        void RemoveSortedNodes(const std_vector<Size_t>& sortedNodeIndices, const bool keepOrder)
+        {
+            using NodeRelocation_t = typename Node_t::NodeRelocation;
+            const Size_t removedCount = (Size_t)sortedNodeIndices.size();
+            if (removedCount == 0) return;
+
+            auto& internalChunk = GetInternalChunk(*this);
+            const Size_t nodeCountOld = internalChunk.NodeCount;
+            const Size_t nodeCountNew = nodeCountOld - removedCount;
+            ni_assert(sortedNodeIndices.front() >= 0);
+            ni_assert(sortedNodeIndices.back() < nodeCountOld);
+            const bool hasNodeHandles = NodeHandleTable_t::HasNodeHandles(*this);
+
+            for (Size_t i = 0; i < removedCount;)
+            {
+                Size_t runCount = 1;
+                while (i + runCount < removedCount && sortedNodeIndices[i + runCount] == sortedNodeIndices[i] + runCount)
+                    ++runCount;
+                if (hasNodeHandles)
+                    NodeHandleTable_t::ReleaseNodes(*this, sortedNodeIndices[i], runCount);
+                Node_t::DestructAllNodeComponentsUnsafe(internalChunk, sortedNodeIndices[i], PropNodeCountT<Size_t>(runCount));
+                i += runCount;
+            }
+
+            std_vector<NodeRelocation_t> relocations;
+            if (keepOrder)
+            {
+                // Each range of nodes between 2 removed nodes slides down by the number of nodes removed before it.
+                Size_t nodeIndexTo = sortedNodeIndices[0];
+                for (Size_t i = 0; i < removedCount; ++i)
+                {
+                    const Size_t firstNodeIndexFrom = sortedNodeIndices[i] + 1;
+                    const Size_t endNodeIndexFrom = i + 1 < removedCount ? sortedNodeIndices[i + 1] : nodeCountOld;
+                    if (endNodeIndexFrom <= firstNodeIndexFrom)
+                        continue;
+                    relocations.push_back(NodeRelocation_t{ nodeIndexTo, firstNodeIndexFrom, endNodeIndexFrom - firstNodeIndexFrom });
+                    nodeIndexTo += endNodeIndexFrom - firstNodeIndexFrom;
+                }
+            }
+            else
+            {
+                // There are as many removed nodes below nodeCountNew as there are kept nodes at or above it.
+                Size_t trailingRemovedIndex = (Size_t)(std::lower_bound(sortedNodeIndices.begin(), sortedNodeIndices.end(), nodeCountNew) - sortedNodeIndices.begin());
+                Size_t nodeIndexFrom = nodeCountNew;
+                for (Size_t i = 0; i < removedCount && sortedNodeIndices[i] < nodeCountNew; ++i)
+                {
+                    while (trailingRemovedIndex < removedCount && sortedNodeIndices[trailingRemovedIndex] == nodeIndexFrom)
+                    {
+                        ++trailingRemovedIndex;
+                        ++nodeIndexFrom;
+                    }
+                    const Size_t nodeIndexTo = sortedNodeIndices[i];
+                    if (!relocations.empty()
+                        && relocations.back().FirstNodeIndexTo   + relocations.back().NodeCount == nodeIndexTo
+                        && relocations.back().FirstNodeIndexFrom + relocations.back().NodeCount == nodeIndexFrom)
+                        ++relocations.back().NodeCount;
+                    else
+                        relocations.push_back(NodeRelocation_t{ nodeIndexTo, nodeIndexFrom, 1 });
+                    ++nodeIndexFrom;
+                }
+            }
+
+            Node_t::RelocateAllNodeComponentsUnsafe(internalChunk, relocations.data(), (Size_t)relocations.size());
+            internalChunk.NodeCount = PropNodeCountT<Size_t>(nodeCountNew);
+            if (hasNodeHandles)
+                for (const NodeRelocation_t& relocation : relocations)
+                    NodeHandleTable_t::UpdateNodes(*this, relocation.FirstNodeIndexTo, relocation.NodeCount);
+            StampStructuralChange();
+        }
+
         void SetNodeCapacity(const NodeCapacityT<Size_t> nodeCapacity) { NodeCapacity = nodeCapacity; }
 #ifndef PNC_PROPS_STRICT
         void SetNodeCapacity(const Size_t nodeCapacity) { NodeCapacity = PropNodeCapacityT<Size_t>(nodeCapacity); }
@@ -28,7 +28,6 @@ namespace NiT
         using Base_t::GetNodeCount;
         using Base_t::GetNodeCapacity;
         using Base_t::GetChunkCapacity;
-        using Base_t::AddNodes;
 
         /// <summary>
         /// Add a single node at NodeCount and return the index.
@@ -37,28 +36,109 @@ namespace NiT
         /// <returns></returns>
         Size_t AddNode() 
         { 
-            return AddNodes(1); 
+            return AddNodes(NodeCountT<Size_t>::V_1()); 
         }
         /// <summary>
         /// Add a multiple sequential nodes at NodeCount and return the index of the first node.
         /// It will reallocate with a greater NodeCapacity if NodeCount + count >= NodeCapacity.
         /// </summary>
-        Size_t AddNodes(const Size_t count)
+        Size_t AddNodes(const NodeCountT<Size_t> count)
         {
-            const auto nodeCount =    GetNodeCount();
-            const auto nodeCapacity = GetNodeCapacity();
-            if (nodeCount + count > nodeCapacity)
-            {
-                const NodeCapacityT<Size_t> newNodeCapacity = std::max(nodeCapacity * 2, PropCountToCapacity(nodeCount + count));
-                ReallocateMove(*this, *this, newNodeCapacity, GetChunkCapacity());
-                this->SetNodeCapacity(newNodeCapacity);
-            }
+            GrowFor(count);
             return Base_t::AddNodes(count);
         }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodes(const Size_t count)
+        {
+            return AddNodes(PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple sequential nodes at NodeCount copy constructed from external arrays, see DBucketPointer::AddNodesCopy.
+        /// It will reallocate once with a greater NodeCapacity if NodeCount + count > NodeCapacity.
+        /// </summary>
+        Size_t AddNodesCopy(const void* const* const componentSources, const NodeCountT<Size_t> count)
+        {
+            GrowFor(count);
+            return Base_t::AddNodesCopy(componentSources, count);
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodesCopy(const void* const* const componentSources, const Size_t count)
+        {
+            return AddNodesCopy(componentSources, PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple sequential nodes at NodeCount move constructed from external arrays, see DBucketPointer::AddNodesMove.
+        /// It will reallocate once with a greater NodeCapacity if NodeCount + count > NodeCapacity.
+        /// </summary>
+        Size_t AddNodesMove(void* const* const componentSources, const NodeCountT<Size_t> count)
+        {
+            GrowFor(count);
+            return Base_t::AddNodesMove(componentSources, count);
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodesMove(void* const* const componentSources, const Size_t count)
+        {
+            return AddNodesMove(componentSources, PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple sequential nodes at NodeCount copy constructed from an external array of structures, see DBucketPointer::AddNodesCopyStrided.
+        /// It will reallocate once with a greater NodeCapacity if NodeCount + count > NodeCapacity.
+        /// </summary>
+        Size_t AddNodesCopyStrided(const void* const source, const Size_t sourceStride, const Size_t* const componentOffsets, const NodeCountT<Size_t> count)
+        {
+            GrowFor(count);
+            return Base_t::AddNodesCopyStrided(source, sourceStride, componentOffsets, count);
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodesCopyStrided(const void* const source, const Size_t sourceStride, const Size_t* const componentOffsets, const Size_t count)
+        {
+            return AddNodesCopyStrided(source, sourceStride, componentOffsets, PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Move a range of nodes from another container, of any structure, to the end of this container and return the index of the first node added.
+        /// It will reallocate with a greater NodeCapacity if NodeCount + nodeCount > NodeCapacity.
+        /// </summary>
+        template<typename TContainerFrom>
+        Size_t MigrateNodes(TContainerFrom& containerFrom, const Size_t firstNodeIndexFrom, const Size_t nodeCount)
+        {
+            GrowFor(nodeCount);
+            return Base_t::MigrateNodes(containerFrom, firstNodeIndexFrom, PropNodeCountT<Size_t>(nodeCount));
+        }
+
+        /// <summary>
+        /// Reallocate with exactly nodeCapacity nodes if the current NodeCapacity is smaller.
+        /// Use before adding a known number of nodes in multiple calls to reallocate only once.
+        /// </summary>
+        void Reserve(const NodeCapacityT<Size_t> nodeCapacity)
+        {
+            if (nodeCapacity <= GetNodeCapacity())
+                return;
+            ReallocateMove(*this, *this, nodeCapacity, GetChunkCapacity());
+            this->SetNodeCapacity(nodeCapacity);
+        }
 
         // TODO void ShrinkToFit()
     protected:
         using TBase::SetNodeCapacity;
         using TBase::ReallocateMove;
+
+        /// <summary>
+        /// Reallocate with a greater NodeCapacity if NodeCount + count > NodeCapacity, at least doubling it.
+        /// </summary>
+        void GrowFor(const Size_t count)
+        {
+            const auto nodeCount =    GetNodeCount();
+            const auto nodeCapacity = GetNodeCapacity();
+            if (nodeCount + count > nodeCapacity)
+                Reserve(std::max(nodeCapacity * 2, PropCountToCapacity(nodeCount + count)));
+        }
     };
 }
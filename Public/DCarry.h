@@ -6,7 +6,11 @@
 
 namespace NiT
 {
-    //TODO complete
+    /// <summary>
+    /// Container of Chunk, Node and their component data.
+    /// 
+    /// A Barrel that reallocates with a greater ChunkCapacity when chunk elements are added passed its capacity, see DCarryPointer.
+    /// </summary>
     template<typename TBase>
     struct DCarry : public TBase
     {
@@ -20,9 +24,7 @@ namespace NiT
         using typename Base_t::Node_t;
         using typename Base_t::ChunkPointerInternal_t;
         using typename Base_t::ChunkPointer_t;
-        using typename Base_t::Chunk_t;
         using typename Base_t::ArrayExtension_t;
-        using typename Base_t::ChunkPointerInternal_t;
         using typename Base_t::ChunkPointerElementInternal_t;
 
         DCarry() = default;
@@ -31,51 +33,68 @@ namespace NiT
         {
         }
 
-        // At capacity Uniform ChunkBunch
+        // Full Uniform Carry
         DCarry(const ChunkStructure_t* const chunkStructure,
                const ChunkCountT<       Size_t> chunkCount,
                const NodeCountPerChunkT<Size_t> nodeCountPerChunk)
-            : Base_t(chunkStructure,
+            : DCarry(chunkStructure,
+                     PropCountToCapacity(chunkCount),
+                     nodeCountPerChunk,
                      chunkCount,
-                     PropChunkCapacityT<Size_t>(chunkCount),
-                     PropNodeCountT<    Size_t>(chunkCount* nodeCountPerChunk),
-                     PropNodeCapacityT< Size_t>(chunkCount* nodeCountPerChunk),
-                     nodeCountPerChunk)
+                     PropCountToCapacity(nodeCountPerChunk))
         {
         }
 
-        // Empty, Partial or Full Uniform array
+        // Empty, Partial or Full Uniform Carry
         // nodeCountPerChunk may be 0.
         DCarry(const ChunkStructure_t* const chunkStructure,
                const ChunkCapacityT<    Size_t> chunkCapacity,
                const NodeCountPerChunkT<Size_t> nodeCountPerChunk,
                const ChunkCountT<       Size_t> chunkCount)
+            : DCarry(chunkStructure,
+                     chunkCapacity,
+                     nodeCountPerChunk,
+                     chunkCount,
+                     PropCountToCapacity(nodeCountPerChunk))
+        {
+        }
+
+        // Empty, Partial or Full Uniform Carry with additional node capacity per chunk.
+        // nodeCountPerChunk may be 0.
+        // Chunk elements can be added as long as the total NodeCount fits in chunkCapacity * nodeCapacityPerChunk.
+        DCarry(const ChunkStructure_t* const chunkStructure,
+               const ChunkCapacityT<       Size_t> chunkCapacity,
+               const NodeCountPerChunkT<   Size_t> nodeCountPerChunk,
+               const ChunkCountT<          Size_t> chunkCount,
+               const NodeCapacityPerChunkT<Size_t> nodeCapacityPerChunk)
             : Base_t(chunkStructure,
                      chunkCount,
                      chunkCapacity,
                      PropNodeCountT<   Size_t>(chunkCount *    nodeCountPerChunk),
-                     PropNodeCapacityT<Size_t>(chunkCapacity * nodeCountPerChunk),
-                     nodeCountPerChunk)
+                     PropNodeCapacityT<Size_t>(chunkCapacity * nodeCapacityPerChunk),
+                     nodeCountPerChunk,
+                     nodeCapacityPerChunk)
         {
             ni_assert(chunkCapacity >= 0);
             ni_assert(nodeCountPerChunk >= 0);
             ni_assert(chunkCount >= 0);
             ni_assert(chunkCount <= chunkCapacity);
+            ni_assert(nodeCountPerChunk <= nodeCapacityPerChunk);
         }
 
-        // Empty, Partial or Full Uniform array with additional node capacity.
+        // Empty, Partial or Full Uniform Carry with a total node capacity.
         // nodeCountPerChunk may be 0.
+        // nodeCapacity is rounded up to a whole NodeCapacityPerChunk for each of the chunkCapacity chunk elements.
         DCarry(const ChunkStructure_t* const chunkStructure,
                const ChunkCapacityT<    Size_t> chunkCapacity,
                const NodeCountPerChunkT<Size_t> nodeCountPerChunk,
                const ChunkCountT<       Size_t> chunkCount,
                const NodeCapacityT<     Size_t> nodeCapacity)
-            : Base_t(chunkStructure,
-                     chunkCount,
+            : DCarry(chunkStructure,
                      chunkCapacity,
-                     PropNodeCountT<Size_t>(chunkCount * nodeCountPerChunk),
-                     nodeCapacity,
-                     nodeCountPerChunk)
+                     nodeCountPerChunk,
+                     chunkCount,
+                     Base_t::NodeCapacityPerChunkFor(nodeCapacity, chunkCapacity, nodeCountPerChunk))
         {
         }
     };
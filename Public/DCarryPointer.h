@@ -6,7 +6,11 @@
 
 namespace NiT
 {
-    // TODO complete
+    /// <summary>
+    /// Will reallocate with a greater ChunkCapacity when adding chunk elements passed the current ChunkCapacity or NodeCapacity.
+    /// It will not shrink ChunkCapacity nor NodeCapacity when chunk elements are removed.
+    /// </summary>
+    /// <typeparam name="TBase"></typeparam>
     template<typename TBase>
     struct DCarryPointer : public TBase
     {
@@ -23,11 +27,74 @@ namespace NiT
         using Base_t::Base_t;
         using Base_t::GetNodeCount;
         using Base_t::GetNodeCapacity;
+        using Base_t::GetNodeCapacityPerChunk;
+        using Base_t::GetChunkCount;
         using Base_t::GetChunkCapacity;
-        using Base_t::AddNodes;
 
-        // TODO override AddChunks so it grows when reaching capacity
+        /// <summary>
+        /// Add a single chunk element at index ChunkCount with nodeCount constructed nodes and return its index.
+        /// It will reallocate with a greater ChunkCapacity if ChunkCount == ChunkCapacity or if the nodes do not fit in NodeCapacity.
+        /// </summary>
+        Size_t AddChunk(const NodeCountT<Size_t> nodeCount)
+        {
+            return AddChunks(ChunkCountT<Size_t>::V_1(), NodeCountPerChunkT<Size_t>((Size_t)nodeCount));
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddChunk(const Size_t nodeCount)
+        {
+            return AddChunk(PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+        /// <summary>
+        /// Add multiple chunk elements at index ChunkCount, each with nodeCountPerChunk constructed nodes, and return the index of the first chunk element added.
+        /// It will reallocate with a greater ChunkCapacity if the chunk elements or their nodes do not fit in the current capacity.
+        /// </summary>
+        Size_t AddChunks(const ChunkCountT<Size_t> chunkCount, const NodeCountPerChunkT<Size_t> nodeCountPerChunk)
+        {
+            GrowFor(chunkCount, chunkCount * nodeCountPerChunk);
+            return Base_t::AddChunks(chunkCount, nodeCountPerChunk);
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddChunks(const Size_t chunkCount, const Size_t nodeCountPerChunk)
+        {
+            return AddChunks(PropChunkCountT<Size_t>(chunkCount), PropNodeCountPerChunkT<Size_t>(nodeCountPerChunk));
+        }
+#endif
+
+        /// <summary>
+        /// Reallocate with at least chunkCapacity chunks and nodeCapacityPerChunk nodes per chunk if the current capacity is smaller.
+        /// Use before adding a known number of chunk elements in multiple calls to reallocate only once.
+        /// </summary>
+        void Reserve(const ChunkCapacityT<Size_t> chunkCapacity, const NodeCapacityPerChunkT<Size_t> nodeCapacityPerChunk)
+        {
+            if (chunkCapacity <= GetChunkCapacity() && nodeCapacityPerChunk <= GetNodeCapacityPerChunk())
+                return;
+            ReallocateChunks(std::max(chunkCapacity,        GetChunkCapacity()),
+                             std::max(nodeCapacityPerChunk, GetNodeCapacityPerChunk()));
+        }
+
+        // TODO void ShrinkToFit()
     protected:
-        using TBase::SetNodeCapacity;
+        using Base_t::ReallocateChunks;
+
+        /// <summary>
+        /// Reallocate with a greater capacity if chunkCount chunk elements totalling nodeCount nodes do not fit.
+        /// ChunkCapacity at least doubles when the chunk elements do not fit and NodeCapacityPerChunk at least doubles when the nodes do not fit.
+        /// </summary>
+        void GrowFor(const ChunkCountT<Size_t> chunkCount, const NodeCountT<Size_t> nodeCount)
+        {
+            const Size_t chunkCountNew = GetChunkCount() + chunkCount;
+            const Size_t nodeCountNew =  GetNodeCount()  + nodeCount;
+            if (chunkCountNew <= GetChunkCapacity() && nodeCountNew <= GetNodeCapacity())
+                return;
+            const Size_t chunkCapacity = chunkCountNew <= GetChunkCapacity()
+                ? (Size_t)GetChunkCapacity()
+                : std::max<Size_t>(GetChunkCapacity() * 2, chunkCountNew);
+            const Size_t nodeCapacityPerChunk = nodeCountNew <= chunkCapacity * GetNodeCapacityPerChunk()
+                ? (Size_t)GetNodeCapacityPerChunk()
+                : std::max<Size_t>(GetNodeCapacityPerChunk() * 2, (nodeCountNew + chunkCapacity - 1) / chunkCapacity);
+            Reserve(PropChunkCapacityT<Size_t>(chunkCapacity), PropNodeCapacityPerChunkT<Size_t>(nodeCapacityPerChunk));
+        }
     };
 }
@@ -4,6 +4,7 @@
 #pragma once
 #include "common.h"
 #include "Node.h"
+#include "NodeHandle.h"
 
 namespace NiT
 {
@@ -214,6 +215,7 @@ namespace NiT
                         containerFrom, 0/*:firstNodeIndexFrom*/, 0/*:firstChunkIndexFrom*/,
                                        nodeCapacity,             chunkCapacity,
                                        nodeCount,                chunkCount);
+            NodeHandleTableT<ChunkStructure_t>::DetachCopy(containerTo, nodeCount, chunkCount);
         }
         template<typename TContainer>
         static void AllocateCopy(TContainer& containerTo, const TContainer& containerFrom)
@@ -254,6 +256,7 @@ namespace NiT
                         containerFrom,         0/*:firstNodeIndexFrom*/, 0/*:firstChunkIndexFrom*/,
                                                nodeCapacity,             chunkCapacity,
                                                nodeCount,                chunkCount);
+            NodeHandleTableT<ChunkStructure_t>::DetachCopy(containerToReallocate, nodeCount, chunkCount);
         }
         template<typename TContainer>
         static void ReallocateCopy(TContainer& containerToReallocate, const TContainer& containerFrom)
@@ -313,15 +316,20 @@ namespace NiT
             const auto chunkCount =    container.GetChunkCount();
             void** const componentDataArrayTo = TContainer::GetInternalChunk(container).ComponentDataArray;
             const ChunkStructure_t& structure = container.GetStructure();
+            Node_t::TrackMemory(structure, nodeCapacity, chunkCapacity, false);
+            const auto getData = Node_t::GetComponentDataArrayFunction(componentDataArrayTo);
+            structure.Plan.Node. DestructUnsafe(getData, 0/*:firstNodexIndex*/, nodeCount);
+            structure.Plan.Chunk.DestructUnsafe(getData, 0/*:firstChunkIndex*/, chunkCount);
+#ifdef NI_MEMORY_SINGLE_BLOCK
+            Node_t::FreeBlockUnsafe(structure, componentDataArrayTo, nodeCapacity, chunkCapacity);
+#else
             auto componentCount = structure.GetComponentCount();
             for (Size_t i = 0; i < componentCount; ++i)
             {
                 const ComponentType_t& componentType = structure.GetComponentType(i);
-                componentType.DestructComponentUnsafe(componentDataArrayTo[i], 
-                                  0/*:firstNodexIndex*/, 0/*:firstChunkIndex*/,
-                                  nodeCount,             chunkCount);
                 ni_free_clean(componentDataArrayTo[i], componentType.GetSize(nodeCapacity, chunkCapacity), componentType.GetAlignment());
             }
+#endif
         }
     };
 }
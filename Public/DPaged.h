@@ -0,0 +1,294 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Container of Node and their component data.
+    ///
+    /// Container with a variable NodeCount of constructed nodes spread over a growable list of fixed NodeCapacityPerChunk pages.
+    /// Each page is a Bucket of TPage type allocated on its own, so adding nodes never reallocates nor moves existing nodes:
+    /// component pointers of a node stay valid until the node itself is removed or moved by a removal.
+    ///
+    /// Nodes are packed: all pages are full except the last one, so node index i is in page (i / NodeCapacityPerChunk).
+    /// Pages emptied by removals are kept in a free list and reused before allocating new ones.
+    ///
+    /// Exposed as an array of chunks to runners, each page being one element chunk, see AlgorithmRunnerPaged.
+    /// </summary>
+    /// <typeparam name="TPage">Owning bucket container type of a page, ex.: BucketT</typeparam>
+    template<typename TPage>
+    struct DPaged
+    {
+    public:
+        using Self_t = DPaged<TPage>;
+        using Page_t = TPage;
+        using ChunkStructure_t = typename Page_t::ChunkStructure_t;
+        using Size_t = typename Page_t::Size_t;
+        using ComponentType_t = typename ChunkStructure_t::ComponentType_t;
+        using Node_t = typename Page_t::Node_t;
+
+    protected:
+        const ChunkStructure_t* Structure;
+
+        /// <summary>
+        /// NodeCapacity of each page.
+        /// </summary>
+        NodeCapacityPerChunkT<Size_t> NodeCapacityPerChunk;
+
+        /// <summary>
+        /// Pages holding nodes, all full except the last one.
+        /// </summary>
+        std_vector<Page_t*> Pages;
+
+        /// <summary>
+        /// Empty pages ready to be reused.
+        /// </summary>
+        std_vector<Page_t*> FreePages;
+
+        NodeCountT<Size_t> NodeCount;
+
+    public:
+        /// <summary>
+        /// Create a VoidNull Container.
+        /// </summary>
+        DPaged()
+            : Structure(nullptr)
+            , NodeCapacityPerChunk(0)
+            , NodeCount(0)
+        {
+        }
+
+        /// <summary>
+        /// Create an empty Container allocating pages of nodeCapacityPerChunk nodes when nodes are added.
+        /// </summary>
+        DPaged(const ChunkStructure_t* const chunkStructure, const NodeCapacityPerChunkT<Size_t> nodeCapacityPerChunk)
+            : Structure(chunkStructure)
+            , NodeCapacityPerChunk(nodeCapacityPerChunk)
+            , NodeCount(0)
+        {
+            ni_assert(nodeCapacityPerChunk > 0);
+        }
+#ifndef PNC_PROPS_STRICT
+        DPaged(const ChunkStructure_t* const chunkStructure, const Size_t nodeCapacityPerChunk)
+            : DPaged(chunkStructure, PropNodeCapacityPerChunkT<Size_t>(nodeCapacityPerChunk))
+        {
+        }
+#endif
+
+        DPaged(Self_t&& o)
+            : Structure(o.Structure)
+            , NodeCapacityPerChunk(o.NodeCapacityPerChunk)
+            , Pages(std::move(o.Pages))
+            , FreePages(std::move(o.FreePages))
+            , NodeCount(o.NodeCount)
+        {
+            o.Pages.clear();
+            o.FreePages.clear();
+            o.NodeCount = NodeCountT<Size_t>::V_0();
+        }
+
+        Self_t& operator=(Self_t&& o)
+        {
+            if (this == &o)
+                return *this;
+            DeleteAllPages();
+            Structure = o.Structure;
+            NodeCapacityPerChunk = o.NodeCapacityPerChunk;
+            Pages = std::move(o.Pages);
+            FreePages = std::move(o.FreePages);
+            NodeCount = o.NodeCount;
+            o.Pages.clear();
+            o.FreePages.clear();
+            o.NodeCount = NodeCountT<Size_t>::V_0();
+            return *this;
+        }
+
+        DPaged(const Self_t& o) = delete;
+        Self_t& operator=(const Self_t& o) = delete;
+
+        ~DPaged()
+        {
+            DeleteAllPages();
+        }
+
+        bool IsNull()const { return Structure == nullptr; }
+        const ChunkStructure_t& GetStructure()const { return *Structure; }
+
+        NodeCountT<Size_t> GetNodeCount()const { return NodeCount; }
+
+        /// <summary>
+        /// Number of nodes the allocated pages in use can hold without allocating or reusing a page.
+        /// </summary>
+        NodeCapacityT<Size_t> GetNodeCapacity()const { return PropNodeCapacityT<Size_t>((Size_t)Pages.size() * NodeCapacityPerChunk); }
+        NodeCapacityPerChunkT<Size_t> GetNodeCapacityPerChunk()const { return NodeCapacityPerChunk; }
+
+        /// <summary>
+        /// Number of pages holding nodes.
+        /// </summary>
+        ChunkCountT<Size_t> GetChunkCount()const { return PropChunkCountT<Size_t>((Size_t)Pages.size()); }
+        Size_t GetFreePageCount()const { return (Size_t)FreePages.size(); }
+
+              Page_t& operator[](const Size_t pageIndex)      { return *Pages[pageIndex]; }
+        const Page_t& operator[](const Size_t pageIndex)const { return *Pages[pageIndex]; }
+
+        Size_t GetPageIndex(const Size_t nodeIndex)const { return nodeIndex / NodeCapacityPerChunk; }
+        Size_t GetNodeIndexInPage(const Size_t nodeIndex)const { return nodeIndex % NodeCapacityPerChunk; }
+
+        /// <summary>
+        /// Get the pointer to a component's memory array in a page.
+        /// </summary>
+        template<typename TComponent>
+        TComponent* GetComponentData(const Size_t pageIndex) { return Pages[pageIndex]->template GetComponentData<TComponent>(); }
+
+        /// <summary>
+        /// Get a node's component by node index.
+        /// </summary>
+        template<typename TComponent>
+        TComponent& GetComponent(const Size_t nodeIndex)
+        {
+            ni_assert(nodeIndex >= 0 && nodeIndex < NodeCount);
+            return GetComponentData<TComponent>(GetPageIndex(nodeIndex))[GetNodeIndexInPage(nodeIndex)];
+        }
+
+        /// <summary>
+        /// Add a single node at index NodeCount and return the index.
+        /// </summary>
+        Size_t AddNode()
+        {
+            return AddNodes(NodeCountT<Size_t>::V_1());
+        }
+
+        /// <summary>
+        /// Add multiple sequential nodes at index NodeCount and return the index of the first node added.
+        /// Fills the last page then takes pages from the free list, or allocates new ones, without moving any existing node.
+        /// </summary>
+        Size_t AddNodes(const NodeCountT<Size_t> count)
+        {
+            ni_assert(!IsNull());
+            ni_assert(count >= 0);
+            const Size_t firstIndex = NodeCount;
+            Size_t remaining = count;
+            while (remaining > 0)
+            {
+                if (Pages.empty() || Pages.back()->GetNodeCount() == NodeCapacityPerChunk)
+                    AcquirePage();
+                Page_t& page = *Pages.back();
+                const Size_t pageCount = std::min<Size_t>(remaining, page.AvailableNodes());
+                page.AddNodes(PropNodeCountT<Size_t>(pageCount));
+                remaining -= pageCount;
+            }
+            NodeCount += count;
+            return firstIndex;
+        }
+#ifndef PNC_PROPS_STRICT
+        Size_t AddNodes(const Size_t count)
+        {
+            return AddNodes(PropNodeCountT<Size_t>(count));
+        }
+#endif
+
+        /// <summary>
+        /// Remove a range of nodes and close the gap with the last nodes of the container, which will break the previous ordering of nodes.
+        /// The removed nodes of each page are replaced by the last nodes of their page in one relocation, and the page is refilled
+        /// with the last nodes of the container in one migration per source page.
+        /// A page emptied is moved to the free list.
+        /// </summary>
+        void RemoveNode(const Size_t firstNodeIndex, const NodeCountT<Size_t> nodeCount = NodeCountT<Size_t>::V_1())
+        {
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(firstNodeIndex + nodeCount <= NodeCount);
+            if (nodeCount == 0)
+                return;
+
+            // From the highest page down so the nodes moving in are never part of the range.
+            const Size_t lastNodeIndex = firstNodeIndex + nodeCount - 1;
+            for (Size_t pageIndex = GetPageIndex(lastNodeIndex); pageIndex >= GetPageIndex(firstNodeIndex); --pageIndex)
+            {
+                const Size_t pageFirstNodeIndex = pageIndex * NodeCapacityPerChunk;
+                const Size_t firstIndexInPage = std::max<Size_t>(firstNodeIndex, pageFirstNodeIndex) - pageFirstNodeIndex;
+                const Size_t endIndexInPage = std::min<Size_t>(lastNodeIndex + 1, pageFirstNodeIndex + NodeCapacityPerChunk) - pageFirstNodeIndex;
+                Page_t& page = *Pages[pageIndex];
+                page.RemoveNode(firstIndexInPage, PropNodeCountT<Size_t>(endIndexInPage - firstIndexInPage));
+
+                // page's own last nodes filled the gap, refill page with the container's last nodes.
+                while (&page != Pages.back() && page.AvailableNodes() > 0)
+                {
+                    Page_t& lastPage = *Pages.back();
+                    const Size_t migratingNodeCount = std::min<Size_t>(page.AvailableNodes(), lastPage.GetNodeCount());
+                    page.MigrateNodes(lastPage, (Size_t)lastPage.GetNodeCount() - migratingNodeCount, PropNodeCountT<Size_t>(migratingNodeCount));
+                    if (lastPage.GetNodeCount() == 0)
+                        ReleaseLastPage();
+                }
+                if (Pages.back()->GetNodeCount() == 0)
+                    ReleaseLastPage();
+            }
+            NodeCount -= nodeCount;
+        }
+#ifndef PNC_PROPS_STRICT
+        void RemoveNode(const Size_t firstNodeIndex, const Size_t nodeCount)
+        {
+            RemoveNode(firstNodeIndex, PropNodeCountT<Size_t>(nodeCount));
+        }
+#endif
+
+        /// <summary>
+        /// Destruct all nodes and move all pages to the free list.
+        /// ChunkComponents of the pages are NOT destructed.
+        /// </summary>
+        void Clear()
+        {
+            for (Page_t* page : Pages)
+            {
+                page->Clear();
+                FreePages.push_back(page);
+            }
+            Pages.clear();
+            NodeCount = NodeCountT<Size_t>::V_0();
+        }
+
+        /// <summary>
+        /// Delete all pages in the free list.
+        /// </summary>
+        void DeleteFreePages()
+        {
+            for (Page_t* page : FreePages)
+                ni_delete_dirty(page);
+            FreePages.clear();
+        }
+
+    protected:
+        void AcquirePage()
+        {
+            if (!FreePages.empty())
+            {
+                // ChunkComponents of a free page still hold the state of its previous nodes, start the page anew.
+                Page_t& page = *FreePages.back();
+                Node_t::DestructAllChunkComponentsUnsafe(page, 0, ChunkCountT<Size_t>::V_1());
+                Node_t::ConstructAllChunkComponentsUnsafe(page, 0, ChunkCountT<Size_t>::V_1());
+                Pages.push_back(&page);
+                FreePages.pop_back();
+                return;
+            }
+            Pages.push_back(ni_new(Page_t)(Structure, PropNodeCapacityT<Size_t>((Size_t)NodeCapacityPerChunk)));
+        }
+
+        void ReleaseLastPage()
+        {
+            ni_assert(Pages.back()->GetNodeCount() == 0);
+            FreePages.push_back(Pages.back());
+            Pages.pop_back();
+        }
+
+        void DeleteAllPages()
+        {
+            for (Page_t* page : Pages)
+                ni_delete_dirty(page);
+            Pages.clear();
+            DeleteFreePages();
+        }
+    };
+}
@@ -24,6 +24,11 @@ namespace NiT
         using ChunkTreeNode_t = ChunkTreeNodeT<Self_t>;
         ChunkTreeNode_t Tree;
 
+        /// <summary>
+        /// Version of the structure of the tree when this container is its root, unused otherwise.
+        /// </summary>
+        uint32 TreeVersion = NewTreeVersion();
+
     protected:
         DTreePointer()
             :Base_t()
@@ -59,6 +64,7 @@ namespace NiT
                     if (c == Tree.FirstChild)
                         break;
                 }
+            IncrementTreeVersion();
         }
         DTreePointer& operator=(const DTreePointer&) = delete;
 
@@ -88,15 +94,42 @@ namespace NiT
         /// </summary>
         Self_t* GetNextSiblingChunk()const { return Tree.NextSibling; }
 
+        /// <summary>
+        /// Get the root of the tree this container is part of, itself if it has no parent.
+        /// </summary>
+        Self_t* GetRootChunk()
+        {
+            Self_t* root = this;
+            while (root->Tree.Parent)
+                root = root->Tree.Parent;
+            return root;
+        }
+        const Self_t* GetRootChunk()const { return const_cast<Self_t*>(this)->GetRootChunk(); }
+
+        /// <summary>
+        /// Version of the structure of the tree this container is part of, kept on its root.
+        /// Changes each time a container is inserted, extracted or moved in that tree,
+        /// so anything cached from walking the tree is up to date as long as the version is the same.
+        /// Versions are unique across all trees of this container type, so a container moved to another tree also gets a new version.
+        /// </summary>
+        uint32 GetTreeVersion()const { return GetRootChunk()->TreeVersion; }
+
         /// <summary>
         /// Extract this KTreePointerT from any Tree.
         /// </summary>
         void Extract()
         {
+            if (Tree.IsExtracted())
+                return;
+            IncrementTreeVersion();
+            if (Tree.Parent && Tree.Parent->Tree.FirstChild == this)
+                Tree.Parent->Tree.FirstChild = Tree.NextSibling == this ? nullptr : Tree.NextSibling;
             Tree.PreviousSibling->Tree.NextSibling = Tree.NextSibling;
             Tree.NextSibling->Tree.PreviousSibling = Tree.PreviousSibling;
             Tree.PreviousSibling = nullptr;
             Tree.NextSibling = nullptr;
+            Tree.Parent = nullptr;
+            IncrementTreeVersion();
         }
 
         /// <summary>
@@ -151,6 +184,7 @@ namespace NiT
                 child->Tree.NextSibling = child;
                 child->Tree.PreviousSibling = child;
                 Tree.FirstChild = child;
+                IncrementTreeVersion();
             }
             else
             {
@@ -172,6 +206,7 @@ namespace NiT
                 child->Tree.NextSibling = child;
                 child->Tree.PreviousSibling = child;
                 Tree.FirstChild = child;
+                IncrementTreeVersion();
             }
             else
             {
@@ -190,7 +225,9 @@ namespace NiT
             last->Tree.NextSibling = sibling;
             sibling->Tree.PreviousSibling = last;
             sibling->Tree.NextSibling = this;
+            sibling->Tree.Parent = Tree.Parent;
             Tree.PreviousSibling = sibling;
+            IncrementTreeVersion();
         }
 
         /// <summary>
@@ -201,5 +238,20 @@ namespace NiT
         {
             Tree.NextSibling->InsertPreviousSibling(sibling);
         }
+
+    protected:
+        /// <summary>
+        /// Get a tree version never returned before for this container type.
+        /// </summary>
+        static uint32 NewTreeVersion()
+        {
+            static std::atomic<uint32> lastTreeVersion(0);
+            return lastTreeVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        /// <summary>
+        /// Give a new version to the tree this container is currently part of.
+        /// </summary>
+        void IncrementTreeVersion() { GetRootChunk()->TreeVersion = NewTreeVersion(); }
     };
 }
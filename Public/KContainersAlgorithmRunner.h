@@ -42,7 +42,7 @@ namespace NiT::Routing
                 return false;
             auto& parentChunk = this->Container->GetParentChunk()->GetChunk();
             const auto& chunkStructure = parentChunk.GetStructure();
-            auto index = chunkStructure.GetComponentTypeIndexInChunk(&typeid(T));
+            auto index = chunkStructure.template GetComponentTypeIndexInChunk<T>();
             if (index < 0)
                 return false;
             component = (T*)parentChunk.GetComponentData(index);
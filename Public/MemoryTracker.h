@@ -3,15 +3,34 @@
 
 #pragma once
 #include "common.h"
+#include "ChunkAllocator.h"
+
+// Backend used by the memory macros and the MemoryTracker.
+// Define NI_CHUNK_ALLOCATOR to recycle memory blocks with the size-class ChunkAllocator instead of FMemory.
+#ifndef NI_OVERRIDE_MEMORY_BACKEND
+#   ifdef NI_CHUNK_ALLOCATOR
+#       define ni_backend_alloc(size, align) ::NiT::ChunkAllocator::Allocate(size, align)
+#       define ni_backend_free(ptr, size, align) ::NiT::ChunkAllocator::Deallocate(ptr, size, align)
+#   else
+#       define ni_backend_alloc(size, align) FMemory::Malloc(size, align)
+#       define ni_backend_free(ptr, size, align) FMemory::Free(ptr)
+#   endif
+#endif
 
 #ifndef NI_MEMORYTRACKER
 #   ifndef NI_OVERRIDE_MEMORY_MACROS
-#       define ni_alloc(size, align) FMemory::Malloc(size, align)
-#       define ni_free_dirty(ptr, size, align) FMemory::Free(ptr)
-#       define ni_free_clean(ptr, size, align) FMemory::Free(ni_clean(ptr))
-#       define ni_new(type) new type
-#       define ni_delete_dirty(ptr) delete ptr
-#       define ni_delete_clean(ptr) delete ni_clean(ptr)
+#       define ni_alloc(size, align) ni_backend_alloc(size, align)
+#       define ni_free_dirty(ptr, size, align) ni_backend_free(ptr, size, align)
+#       define ni_free_clean(ptr, size, align) ni_backend_free(ni_clean(ptr), size, align)
+#       ifdef NI_CHUNK_ALLOCATOR
+#           define ni_new(type) new (::NiT::ChunkAllocator::Allocate<type>()) type
+#           define ni_delete_dirty(ptr) ::NiT::ChunkAllocator::Delete(ptr)
+#           define ni_delete_clean(ptr) ::NiT::ChunkAllocator::Delete(ni_clean(ptr))
+#       else
+#           define ni_new(type) new type
+#           define ni_delete_dirty(ptr) delete ptr
+#           define ni_delete_clean(ptr) delete ni_clean(ptr)
+#       endif
 #       define ni_assert_owns(ptr, count) 
 #       define ni_owns(ptr, count) true
 #       define ni_allocation_count ((int)0)
@@ -24,16 +43,110 @@
 #       define ni_new(type) new (::NiT::MemoryTracker::Allocate<type>()) type
 #       define ni_delete_clean(ptr) ::NiT::MemoryTracker::Delete(ni_clean(ptr))
 #       define ni_delete_dirty(ptr) ::NiT::MemoryTracker::Delete(ptr)
-#       define ni_assert_owns(ptr, count) ni_assert(::NiT::MemoryTracker::Owns(ptr, count))
+#       ifdef NI_MEMORYTRACKER_OWNERSHIP
+#           define ni_assert_owns(ptr, count) ni_assert(::NiT::MemoryTracker::Owns(ptr, count))
+#       else
+#           define ni_assert_owns(ptr, count) 
+#       endif
 #       define ni_owns(ptr, count) ::NiT::MemoryTracker::Owns(ptr, count)
-#       define ni_allocation_count ((int)::NiT::MemoryTracker::Instance.AllocationCount)
+#       define ni_allocation_count ((int)::NiT::MemoryTracker::GetLiveAllocationCount())
 #   endif
+#endif
+
 namespace NiT
 {
+    /// <summary>
+    /// Thread-safe counters of the memory attributed to an owner (the whole tracker, a ChunkStructure or a ComponentType).
+    /// Counters are not copied along with their owner.
+    /// </summary>
+    struct MemoryStats
+    {
+    public:
+        std::atomic<int64> LiveBytes{ 0 };
+        std::atomic<int64> PeakBytes{ 0 };
+        std::atomic<int64> LiveAllocationCount{ 0 };
+        std::atomic<int64> TotalAllocationCount{ 0 };
+
+    public:
+        MemoryStats() = default;
+        MemoryStats(const MemoryStats&) {}
+        MemoryStats& operator=(const MemoryStats&) { return *this; }
+
+        void Add(const int64 bytes)
+        {
+            const int64 liveBytes = LiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            LiveAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            TotalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            int64 peakBytes = PeakBytes.load(std::memory_order_relaxed);
+            while (liveBytes > peakBytes && !PeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed));
+        }
+
+        void Remove(const int64 bytes)
+        {
+            LiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            LiveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Change the size of a live allocation reused in place, without counting a new allocation.
+        /// </summary>
+        void Resize(const int64 bytesOld, const int64 bytesNew)
+        {
+            const int64 bytes = bytesNew - bytesOld;
+            const int64 liveBytes = LiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            int64 peakBytes = PeakBytes.load(std::memory_order_relaxed);
+            while (liveBytes > peakBytes && !PeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed));
+        }
+
+        int64 GetLiveBytes()const { return LiveBytes.load(std::memory_order_relaxed); }
+        int64 GetPeakBytes()const { return PeakBytes.load(std::memory_order_relaxed); }
+        int64 GetLiveAllocationCount()const { return LiveAllocationCount.load(std::memory_order_relaxed); }
+        int64 GetTotalAllocationCount()const { return TotalAllocationCount.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Restart peak tracking from the current live bytes.
+        /// </summary>
+        void ResetPeak() { PeakBytes.store(GetLiveBytes(), std::memory_order_relaxed); }
+    };
+}
+
+#ifdef NI_MEMORYTRACKER
+namespace NiT
+{
+    /// <summary>
+    /// Track all memory allocated with the memory macros.
+    /// Every allocation is prefixed with a Header holding its size, making Allocate and Deallocate O(1) and lock-free.
+    /// With NI_MEMORYTRACKER_OWNERSHIP, allocations are also registered in address-sharded maps so ni_assert_owns
+    /// can validate pointers inside an allocation while only locking the shard of the pointer's address.
+    /// </summary>
     NI_API struct MemoryTracker
     {
     public:
         NI_API static MemoryTracker Instance;
+
+        /// <summary>
+        /// Number of shards in the ownership maps.
+        /// </summary>
+        static constexpr std::size_t ShardCount = 64;
+
+        /// <summary>
+        /// Address granularity used to pick an allocation's shards. Consecutive 64KB granules map to consecutive shards.
+        /// </summary>
+        static constexpr std::size_t GranuleSizeLog2 = 16;
+
+        static constexpr uint32 HeaderMagic = 0x4e694d54;
+
+        /// <summary>
+        /// Stored right before every pointer returned by Allocate.
+        /// </summary>
+        struct Header
+        {
+            std::size_t Size;
+            // Bytes between the backend allocation and the pointer returned by Allocate
+            uint32 Offset;
+            uint32 Magic;
+        };
+
         struct Alloc
         {
             uint8* Base;
@@ -43,39 +156,78 @@ namespace NiT
                 return Base <= ptr && (Base + Size) >= (ptr + size);
             }
         };
-        std::map<uint8*, Alloc> Allocations;
-        int AllocationCount;
+
+        /// <summary>
+        /// Allocations overlapping the address granules of the shard, keyed by their last byte.
+        /// </summary>
+        struct Shard
+        {
+            std::mutex Mutex;
+            std::map<uint8*, Alloc> Allocations;
+        };
+
+        /// <summary>
+        /// Counters of all memory allocated through the tracker.
+        /// </summary>
+        MemoryStats Stats;
+
+#ifdef NI_MEMORYTRACKER_OWNERSHIP
+        Shard Shards[ShardCount];
+#endif
+
+        std::mutex SampleMutex;
+        double SampleTime = 0;
+        int64 SampleAllocationCount = 0;
         
         NI_DEBUG_NOINLINE static void* Allocate(std::size_t const size, std::size_t const alignment)
         {
             MemoryTracker& instance = Instance;
-            void* ptr = FMemory::Malloc(size, alignment);
-            if (ptr)
+            const std::size_t offset = GetHeaderOffset(alignment);
+            uint8* const base = (uint8*)ni_backend_alloc(offset + size, GetBackendAlignment(offset));
+            if (base == nullptr)
+                return nullptr;
+            uint8* const ptr = base + offset;
+            Header& header = GetHeader(ptr);
+            header.Size = size;
+            header.Offset = (uint32)offset;
+            header.Magic = HeaderMagic;
+            instance.Stats.Add(size);
+#ifdef NI_MEMORYTRACKER_OWNERSHIP
+            ForEachShard(ptr, size, [ptr, size](Shard& shard)
             {
-                ++instance.AllocationCount;
-                instance.Allocations.insert({ (uint8*)ptr + size - 1, {(uint8*)ptr, size} });
+                std::lock_guard<std::mutex> lock(shard.Mutex);
+                shard.Allocations.insert({ ptr + std::max<std::size_t>(size, 1) - 1, { ptr, size } });
+            });
+#endif
 #ifdef PNC_MEMORY_ALLOC_LOG
-                UE_LOG(LogTemp, Log, TEXT("Alloc %016x (new count %d)"), ptr, instance.AllocationCount);
+            UE_LOG(LogTemp, Log, TEXT("Alloc %016x (new count %d)"), ptr, (int)instance.Stats.GetLiveAllocationCount());
 #endif
-            }
             return ptr;
         }
         NI_DEBUG_NOINLINE static void Deallocate(void* const ptr, std::size_t const size, std::size_t const alignment)
         {
             MemoryTracker& instance = Instance;
-            if (ptr != nullptr)
+            if (ptr == nullptr)
+                return;
+            Header& header = GetHeader(ptr);
+            ni_assert(header.Magic == HeaderMagic);
+            ni_assert(header.Size >= size);
+            const std::size_t allocatedSize = header.Size;
+            instance.Stats.Remove(allocatedSize);
+#ifdef NI_MEMORYTRACKER_OWNERSHIP
+            ForEachShard((uint8*)ptr, allocatedSize, [ptr, allocatedSize](Shard& shard)
             {
-                //ni_assert(AllocationCount > 0);
-                --Instance.AllocationCount;
+                std::lock_guard<std::mutex> lock(shard.Mutex);
+                shard.Allocations.erase((uint8*)ptr + std::max<std::size_t>(allocatedSize, 1) - 1);
+            });
+#endif
 #ifdef PNC_MEMORY_ALLOC_LOG
-                UE_LOG(LogTemp, Log, TEXT("Free  %016x (new count %d)"), ptr, instance.AllocationCount);
+            UE_LOG(LogTemp, Log, TEXT("Free  %016x (new count %d)"), ptr, (int)instance.Stats.GetLiveAllocationCount());
 #endif
-                auto it = instance.Allocations.lower_bound((uint8*)ptr);
-                ni_assert(it != instance.Allocations.end());
-                ni_assert(it->second.Includes((uint8*)ptr, size));
-                Instance.Allocations.erase(it);
-            }
-            FMemory::Free(ptr);
+            header.Magic = 0;
+            // Free with the recorded size so size-class backends always get back the size they allocated
+            const std::size_t offset = header.Offset;
+            ni_backend_free((uint8*)ptr - offset, offset + allocatedSize, GetBackendAlignment(offset));
         }
 
 
@@ -99,19 +251,94 @@ namespace NiT
             Deallocate(ptr);
         }
 
+        /// <summary>
+        /// If the memory range [ptr, ptr+size) is inside a single tracked allocation.
+        /// Always true without NI_MEMORYTRACKER_OWNERSHIP.
+        /// </summary>
         static bool Owns(const void*const ptr, const std::size_t size=1)
         {
-            MemoryTracker& instance = Instance;
-            auto nearest = instance.Allocations.lower_bound((uint8*)ptr);
-            if (nearest == instance.Allocations.end())
+#ifdef NI_MEMORYTRACKER_OWNERSHIP
+            Shard& shard = Instance.Shards[GetShardIndex((std::size_t)ptr >> GranuleSizeLog2)];
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            auto nearest = shard.Allocations.lower_bound((uint8*)ptr);
+            if (nearest == shard.Allocations.end())
                 return false;
             return nearest->second.Includes((uint8*)ptr, size);
+#else
+            return true;
+#endif
         }
         template<typename T>
         static bool OwnsT(const T*const ptr, const std::size_t count)
         {
             return Owns((void*)ptr, sizeof(T) * count);
         }
+
+    public:
+
+        static const MemoryStats& GetStats() { return Instance.Stats; }
+        static int64 GetLiveBytes() { return Instance.Stats.GetLiveBytes(); }
+        static int64 GetPeakBytes() { return Instance.Stats.GetPeakBytes(); }
+        static int64 GetLiveAllocationCount() { return Instance.Stats.GetLiveAllocationCount(); }
+        static int64 GetTotalAllocationCount() { return Instance.Stats.GetTotalAllocationCount(); }
+
+        /// <summary>
+        /// Get the number of allocations per second since the previous call.
+        /// Returns 0 on the first call.
+        /// </summary>
+        static double SampleAllocationRate()
+        {
+            MemoryTracker& instance = Instance;
+            std::lock_guard<std::mutex> lock(instance.SampleMutex);
+            const double time = FPlatformTime::Seconds();
+            const int64 allocationCount = instance.Stats.GetTotalAllocationCount();
+            const double elapsed = time - instance.SampleTime;
+            const double rate = (instance.SampleTime > 0 && elapsed > 0) ? (allocationCount - instance.SampleAllocationCount) / elapsed : 0;
+            instance.SampleTime = time;
+            instance.SampleAllocationCount = allocationCount;
+            return rate;
+        }
+
+    private:
+        static std::size_t GetHeaderOffset(const std::size_t alignment)
+        {
+            const std::size_t headerAlignment = std::max(alignment, alignof(Header));
+            return (sizeof(Header) + headerAlignment - 1) / headerAlignment * headerAlignment;
+        }
+
+        /// <summary>
+        /// Alignment given to the backend. The header offset is a power of two at least as large as the requested alignment,
+        /// aligning on it keeps the returned pointer aligned and lets Deallocate recover the alignment from the header.
+        /// </summary>
+        static std::size_t GetBackendAlignment(const std::size_t offset)
+        {
+            return offset;
+        }
+
+        static Header& GetHeader(void* const ptr)
+        {
+            return *((Header*)ptr - 1);
+        }
+
+#ifdef NI_MEMORYTRACKER_OWNERSHIP
+        static std::size_t GetShardIndex(const std::size_t granule)
+        {
+            return granule % ShardCount;
+        }
+
+        /// <summary>
+        /// Call function(shard) once for each shard of the granules the memory range overlaps.
+        /// </summary>
+        template<typename TFunction>
+        static void ForEachShard(const uint8* const ptr, const std::size_t size, TFunction function)
+        {
+            const std::size_t firstGranule = (std::size_t)ptr >> GranuleSizeLog2;
+            const std::size_t lastGranule = ((std::size_t)ptr + std::max<std::size_t>(size, 1) - 1) >> GranuleSizeLog2;
+            const std::size_t shardCount = std::min(lastGranule - firstGranule + 1, ShardCount);
+            for (std::size_t i = 0; i < shardCount; ++i)
+                function(Instance.Shards[GetShardIndex(firstGranule + i)]);
+        }
+#endif
     };
 }
 #endif
@@ -28,6 +28,11 @@
 #include "ContainersAlgorithmRunner.h"
 #include "KContainersAlgorithmRunner.h"
 #include "Pipeline.h"
+#include "ParallelPipeline.h"
+#include "StaticChunkStructure.h"
+#include "AlgorithmRunnerTree.h"
+#include "ChunkHierarchy.h"
+#include "NodeHandle.h"
 #include "Components.h"
 #include "routing\AlgorithmRouter.h"
 #include "routing\AlgorithmCacheRouter.h"
@@ -48,6 +53,16 @@ namespace Ni
     /// </summary>
     using ComponentTypeSet = NiT::ComponentTypeSetT<Size_t>;
 
+    /// <summary>
+    /// Dense integer id of each component type, used to find a component type in a ChunkStructure with a single array load.
+    /// </summary>
+    using ComponentTypeId = NiT::ComponentTypeIdT<Size_t>;
+
+    /// <summary>
+    /// Fixed-width bitmask of ComponentTypeId, used to match ChunkStructures against required component types.
+    /// </summary>
+    using ComponentMask = NiT::ComponentMaskT<Size_t>;
+
     /// <summary>
     /// Define who owns a component
     /// </summary>
@@ -65,6 +80,17 @@ namespace Ni
     /// </summary>
     using NiT::ChunkComponent;
 
+    /// <summary>
+    /// Specialize to std::true_type, or declare `static constexpr bool TriviallyRelocatable = true;` in a component type,
+    /// for components that can be moved in memory with a memcpy without running their destructor.
+    /// </summary>
+    using NiT::IsTriviallyRelocatable;
+
+    /// <summary>
+    /// Pass to Algorithm::Run / TryRun to execute an algorithm from multiple threads.
+    /// </summary>
+    using NiT::ParallelPolicy;
+
     /// <summary>
     /// Defines the list of component a container has.
     /// </summary>
@@ -121,6 +147,15 @@ namespace Ni
     /// </summary>
     using NBunch = NiT::BunchT<ChunkStructure>;
 
+    /// <summary>
+    /// A Paged container of components for multiple fixed NodeCapacity pages and multiple nodes.
+    /// A Paged owns its pages, each page being an NBucket allocated on its own.
+    /// A Paged grows by adding pages and never moves its nodes when growing, keeping component pointers valid.
+    /// Figure: |#####| |#####| |##___|...
+    /// Layout: Structure*, NodeCapacityPerChunk, Pages, FreePages, NodeCount
+    /// </summary>
+    using NPaged = NiT::PagedT<ChunkStructure>;
+
     /// <summary>
     /// An ArrayPointer container of components for multiple chunks and multiple nodes.
     /// An ArrayPointer does not own its component data.
@@ -149,6 +184,41 @@ namespace Ni
     /// </summary>
     using NUniformArray = NiT::UniformArrayT<ChunkStructure, NChunkPointer>;
 
+    /// <summary>
+    /// A Barrel container of components for multiple chunks and multiple nodes.
+    /// A Barrel owns its component data.
+    /// A Barrel has a fixed ChunkCapacity and NodeCapacity, and a variable ChunkCount of constructed chunks added and removed with AddChunks/RemoveChunks.
+    /// Figure: |####|###|######|_____|
+    /// Layout: Structure*, void**CDA, NodeCount, ChunkPointer*, ChunkCount, ChunkCapacity, NodeCapacityPerChunk
+    /// </summary>
+    using NBarrel = NiT::ChunkBarrelT<ChunkStructure, NChunkPointer>;
+
+    /// <summary>
+    /// A Carry container of components for multiple chunks and multiple nodes.
+    /// A Carry owns its component data.
+    /// A Carry has a variable ChunkCapacity and NodeCapacity that grow when needed to fit the chunks added with AddChunks.
+    /// Figure: |####|###|######|_____|...
+    /// Layout: Structure*, void**CDA, NodeCount, ChunkPointer*, ChunkCount, ChunkCapacity, NodeCapacityPerChunk
+    /// </summary>
+    using NCarry = NiT::ChunkCarryT<ChunkStructure, NChunkPointer>;
+
+    /// <summary>
+    /// A ChunkStructure with its component types, column order and memory block offsets computed at compile time.
+    /// </summary>
+    template<typename... TComponents>
+    using StaticChunkStructure = NiT::StaticChunkStructureT<Size_t, TComponents...>;
+
+    /// <summary>
+    /// A StaticBucket container of components for one(1) chunk and multiple nodes of a StaticChunkStructure.
+    /// A StaticBucket owns its component data and has a fixed NodeCapacity of allocated nodes.
+    /// Algorithms run on it find their component pointers at constexpr offsets without routing.
+    /// GetChunkPointer() returns an NChunkPointer to interoperate with dynamic containers.
+    /// Figure: |###__|
+    /// Layout: Block*, NodeCount, NodeCapacity, void*CDA[]
+    /// </summary>
+    template<typename... TComponents>
+    using NStaticBucket = NiT::StaticBucketT<StaticChunkStructure<TComponents...>>;
+
     /// <summary>
     /// A KindPointer has a Kind data field usable to identify what kind of container follows the Kind data field in memory.
     /// Layout: Kind
@@ -369,10 +439,50 @@ namespace Ni
     template<typename TPipeline>
     using Pipeline = NiT::PipelineT<TPipeline, ChunkStructure, Size_t>;
 
+    /// <summary>
+    /// Order in which a TreeRunner executes the depth levels of a tree.
+    /// </summary>
+    using NiT::TreeOrder;
+
+    /// <summary>
+    /// Execute an algorithm on all containers of a tree of KTreePointer, one depth level at a time with each level in parallel.
+    /// Keep the runner around to reuse its cached level ordering until the tree is restructured.
+    /// </summary>
+    using TreeRunner = NiT::TreeRunnerT<KTreePointer>;
+
+    /// <summary>
+    /// Contiguous depth-first pre-order array of the containers of a tree of KTreePointer, with parent indices and subtree sizes.
+    /// </summary>
+    using TreeSnapshot = NiT::TreeSnapshotT<KTreePointer>;
+
     using CoParentInChunk = NiT::CoParentInChunkT<Size_t>;
     using CoSingleParentOutsideChunk = NiT::CoSingleParentOutsideChunkT<Size_t>;
     using CoChildrenInChunk = NiT::CoChildrenInChunkT<Size_t>;
 
+    /// <summary>
+    /// Keep the nodes of a chunk with CoParentInChunk sorted parents first and propagate data from parents to children in one linear pass.
+    /// </summary>
+    using ChunkHierarchy = NiT::ChunkHierarchyT<Size_t>;
+
+    /// <summary>
+    /// Stable generational reference to a node, resolved to its current container and index by a NodeHandleTable.
+    /// </summary>
+    using NodeHandle = NiT::NodeHandleT<Size_t>;
+    using NodeLocation = NiT::NodeLocationT<ChunkStructure>;
+    using NodeHandleTable = NiT::NodeHandleTableT<ChunkStructure>;
+
+    /// <summary>
+    /// Add both to a ChunkStructure for its nodes to be referenced by NodeHandles.
+    /// </summary>
+    using CoNodeHandle = NiT::CoNodeHandleT<Size_t>;
+    using CoNodeHandleTable = NiT::CoNodeHandleTableT<ChunkStructure>;
+
+    /// <summary>
+    /// Add to a ChunkStructure to track which component columns were written since an algorithm's last run.
+    /// Algorithms filter chunks with req.Changed(component, lastRunVersion) in their Requirements.
+    /// </summary>
+    using CoChangeVersion = NiT::CoChangeVersionT<Size_t>;
+
     template<typename TIn> NI_FORCEINLINE NiT::NodeCapacityT        <Size_t> PropNodeCapacity        (const TIn& value) { return NiT::PropNodeCapacityT        <Size_t, TIn>(value); }
     template<typename TIn> NI_FORCEINLINE NiT::NodeCountT           <Size_t> PropNodeCount           (const TIn& value) { return NiT::PropNodeCountT           <Size_t, TIn>(value); }
     template<typename TIn> NI_FORCEINLINE NiT::ChunkCapacityT       <Size_t> PropChunkCapacity       (const TIn& value) { return NiT::PropChunkCapacityT       <Size_t, TIn>(value); }
@@ -403,6 +513,9 @@ namespace NiT
     template<> struct PropTraits<const Ni::ChunkStructure*> : public PropTraitsDefault2<Ni::ChunkStructure, const Ni::ChunkStructure*, DStructurePtr> {};
 }
 
+// Depends on the Ni aliases above, and brings CommandBuffer.h which depends on the registry aliases.
+#include "Registry.h"
+
 class FNiModule : public IModuleInterface
 {
 public:
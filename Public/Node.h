@@ -37,28 +37,8 @@ namespace NiT
             ni_assert(firstChunkIndex >= 0);
             ni_assert(chunkCount >= 0);
 
-            if (chunkCount == 0) return;
-
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-#if defined(NI_MEMORY_NODE_CONSTRUCTZERO_TRIVIAL) || defined(NI_MEMORY_NODE_CONSTRUCTZERO)
-            Size_t componentTypeCount = chunkStructure.ChunkComponentIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.ChunkComponentIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->ConstructDataUnsafe(componentData, firstChunkIndex, chunkCount);
-            }
-#else
-            Size_t componentTypeCount = chunkStructure.DefaultConstructibleChunkIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.DefaultConstructibleChunkIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->ConstructDataUnsafe(componentData, firstChunkIndex, chunkCount);
-            }
-#endif
+            chunkStructure.Plan.Chunk.ConstructUnsafe(GetComponentDataFunction(container), firstChunkIndex, chunkCount);
         }
 
         /// <summary>
@@ -77,28 +57,8 @@ namespace NiT
             ni_assert(firstNodeIndex >= 0);
             ni_assert(nodeCount >= 0);
 
-            if (nodeCount == 0) return;
-
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-#if defined(NI_MEMORY_NODE_CONSTRUCTZERO_TRIVIAL) || defined(NI_MEMORY_NODE_CONSTRUCTZERO)
-            Size_t componentTypeCount = chunkStructure.NodeComponentIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.NodeComponentIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->ConstructDataUnsafe(componentData, firstNodeIndex, nodeCount);
-            }
-#else
-            Size_t componentTypeCount = chunkStructure.DefaultConstructibleNodeIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.DefaultConstructibleNodeIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->ConstructDataUnsafe(componentData, firstNodeIndex, nodeCount);
-            }
-#endif
+            chunkStructure.Plan.Node.ConstructUnsafe(GetComponentDataFunction(container), firstNodeIndex, nodeCount);
         }
 
         /// <summary>
@@ -120,12 +80,9 @@ namespace NiT
             ni_assert(chunkCount >= 0);
 
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-            Size_t componentCount = chunkStructure.GetComponentCount();
-            for (Size_t i = 0; i < componentCount; ++i)
-            {
-                const ComponentType_t& componentType = chunkStructure.GetComponentType(i);
-                componentType.ConstructComponentUnsafe(container.GetComponentData(i), firstNodeIndex, firstChunkIndex, nodeCount, chunkCount);
-            }
+            const auto getData = GetComponentDataFunction(container);
+            chunkStructure.Plan.Node. ConstructUnsafe(getData, firstNodeIndex,  nodeCount);
+            chunkStructure.Plan.Chunk.ConstructUnsafe(getData, firstChunkIndex, chunkCount);
         }
         /// <summary>
         /// Destruct all ChunkComponents
@@ -139,28 +96,8 @@ namespace NiT
             ni_assert(firstChunkIndex >= 0);
             ni_assert(chunkCount >= 0);
 
-            if (chunkCount == 0) return;
-
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-#if defined(NI_MEMORY_NODE_CONSTRUCTZERO_TRIVIAL) || defined(NI_MEMORY_NODE_CONSTRUCTZERO)
-            Size_t componentTypeCount = chunkStructure.ChunkComponentIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.ChunkComponentIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->DestructDataUnsafe(componentData, firstChunkIndex, chunkCount);
-            }
-#else
-            Size_t componentTypeCount = chunkStructure.DestructibleChunkIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.DestructibleChunkIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->DestructDataUnsafe(componentData, firstChunkIndex, chunkCount);
-            }
-#endif
+            chunkStructure.Plan.Chunk.DestructUnsafe(GetComponentDataFunction(container), firstChunkIndex, chunkCount);
         }
 
         /// <summary>
@@ -175,28 +112,8 @@ namespace NiT
             ni_assert(firstNodeIndex >= 0);
             ni_assert(nodeCount >= 0);
 
-            if (nodeCount == 0) return;
-
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-#if defined(NI_MEMORY_NODE_CONSTRUCTZERO_TRIVIAL) || defined(NI_MEMORY_NODE_CONSTRUCTZERO)
-            Size_t componentTypeCount = chunkStructure.NodeComponentIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.NodeComponentIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->DestructDataUnsafe(componentData, firstNodeIndex, nodeCount);
-            }
-#else
-            Size_t componentTypeCount = chunkStructure.DestructibleNodeIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.DestructibleNodeIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentData = container.GetComponentData(index);
-                componentType->DestructDataUnsafe(componentData, firstNodeIndex, nodeCount);
-            }
-#endif
+            chunkStructure.Plan.Node.DestructUnsafe(GetComponentDataFunction(container), firstNodeIndex, nodeCount);
         }
 
         /// <summary>
@@ -214,12 +131,9 @@ namespace NiT
             ni_assert(chunkCount >= 0);
 
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-            Size_t componentCount = chunkStructure.GetComponentCount();
-            for (Size_t i = 0; i < componentCount; ++i)
-            {
-                const ComponentType_t* componentType = chunkStructure.Components[i];
-                componentType->DestructComponentUnsafe(container.GetComponentData(i), firstNodeIndex, firstChunkIndex, nodeCount, chunkCount);
-            }
+            const auto getData = GetComponentDataFunction(container);
+            chunkStructure.Plan.Node. DestructUnsafe(getData, firstNodeIndex,  nodeCount);
+            chunkStructure.Plan.Chunk.DestructUnsafe(getData, firstChunkIndex, chunkCount);
         }
 
         /// <summary>
@@ -240,20 +154,37 @@ namespace NiT
             ni_assert(nodeCount >= 0);
             ni_assert(IsSameStructure(containerTo, containerFrom));
 
-            if (nodeCount == 0) return;
+            const ChunkStructure_t& chunkStructure = containerTo.GetStructure();
+            chunkStructure.Plan.Node.MoveConstructForwardUnsafe(GetComponentDataFunction(containerTo),   firstNodeIndexTo,
+                                                                GetComponentDataFunction(containerFrom), firstNodeIndexFrom,
+                                                                nodeCount);
+        }
+
+        /// <summary>
+        /// Relocate all NodeComponents between 2 containers.
+        /// Nodes are move-constructed in containerTo and destructed in containerFrom, 
+        /// trivially relocatable components are only copied with memmove.
+        /// Notes:
+        ///     containerTo and containerFrom CAN be the same but the range of nodes must not overlap forward.
+        ///     Nodes in the range of containerFrom must be considered destructed afterward.
+        /// </summary>
+        template<typename TContainer>
+        static void RelocateAllNodeComponentsForwardUnsafe(
+                        TContainer& containerTo,   const            Size_t firstNodeIndexTo, 
+                        TContainer& containerFrom, const            Size_t firstNodeIndexFrom, 
+                                                   const NodeCountT<Size_t> nodeCount)
+        { 
+            ni_assert(!containerTo.IsNull());
+            ni_assert(firstNodeIndexTo >= 0);
+            ni_assert(!containerFrom.IsNull());
+            ni_assert(firstNodeIndexFrom >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(IsSameStructure(containerTo, containerFrom));
 
             const ChunkStructure_t& chunkStructure = containerTo.GetStructure();
-            Size_t componentTypeCount = chunkStructure.NodeComponentIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
-            {
-                Size_t index = chunkStructure.NodeComponentIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentDataTo =   containerTo.  GetComponentData(index);
-                void* componentDataFrom = containerFrom.GetComponentData(index);
-                componentType->MoveConstructDataForwardUnsafe(componentDataTo,   firstNodeIndexTo,
-                                                              componentDataFrom, firstNodeIndexFrom, 
-                                                              nodeCount);
-            }
+            chunkStructure.Plan.Node.RelocateForwardUnsafe(GetComponentDataFunction(containerTo),   firstNodeIndexTo,
+                                                           GetComponentDataFunction(containerFrom), firstNodeIndexFrom,
+                                                           nodeCount);
         }
 
         /// <summary>
@@ -274,19 +205,270 @@ namespace NiT
             ni_assert(chunkCount >= 0);
             ni_assert(IsSameStructure(containerTo, containerFrom));
 
-            if (chunkCount == 0) return;
+            const ChunkStructure_t& chunkStructure = containerTo.GetStructure();
+            chunkStructure.Plan.Chunk.MoveConstructForwardUnsafe(GetComponentDataFunction(containerTo),   firstChunkIndexTo,
+                                                                 GetComponentDataFunction(containerFrom), firstChunkIndexFrom,
+                                                                 chunkCount);
+        }
+
+        /// <summary>
+        /// Relocate all ChunkComponents between 2 containers.
+        /// Chunks are move-constructed in containerTo and destructed in containerFrom, 
+        /// trivially relocatable components are only copied with memmove.
+        /// Notes:
+        ///     containerTo and containerFrom CAN be the same but the range of chunks must not overlap forward.
+        ///     Chunks in the range of containerFrom must be considered destructed afterward.
+        /// </summary>
+        template<typename TContainer>
+        static void RelocateAllChunkComponentsForwardUnsafe(
+                        TContainer& containerTo,   const             Size_t firstChunkIndexTo, 
+                        TContainer& containerFrom, const             Size_t firstChunkIndexFrom, 
+                                                   const ChunkCountT<Size_t> chunkCount)
+        {
+            ni_assert(!containerTo.IsNull());
+            ni_assert(firstChunkIndexTo >= 0);
+            ni_assert(!containerFrom.IsNull());
+            ni_assert(firstChunkIndexFrom >= 0);
+            ni_assert(chunkCount >= 0);
+            ni_assert(IsSameStructure(containerTo, containerFrom));
 
             const ChunkStructure_t& chunkStructure = containerTo.GetStructure();
-            Size_t componentTypeCount = chunkStructure.ChunkComponentIndex.size();
-            for (Size_t i = 0; i < componentTypeCount; ++i)
+            chunkStructure.Plan.Chunk.RelocateForwardUnsafe(GetComponentDataFunction(containerTo),   firstChunkIndexTo,
+                                                            GetComponentDataFunction(containerFrom), firstChunkIndexFrom,
+                                                            chunkCount);
+        }
+
+        /// <summary>
+        /// Migrate NodeComponents between 2 containers of different structures.
+        /// Component types in both structures are relocated column by column, trivially relocatable ones with a single memmove.
+        /// Component types only in containerTo's structure are default constructed.
+        /// Component types only in containerFrom's structure are destructed.
+        /// Notes:
+        ///     Nodes in the range of containerFrom must be considered destructed afterward.
+        ///     The ranges of nodes must not overlap forward.
+        /// </summary>
+        template<typename TContainerTo, typename TContainerFrom>
+        static void MigrateAllNodeComponentsForwardUnsafe(
+                        TContainerTo&   containerTo,   const            Size_t firstNodeIndexTo, 
+                        TContainerFrom& containerFrom, const            Size_t firstNodeIndexFrom, 
+                                                       const NodeCountT<Size_t> nodeCount)
+        {
+            ni_assert(!containerTo.IsNull());
+            ni_assert(firstNodeIndexTo >= 0);
+            ni_assert(!containerFrom.IsNull());
+            ni_assert(firstNodeIndexFrom >= 0);
+            ni_assert(nodeCount >= 0);
+            if (nodeCount == 0) return;
+
+            const ChunkStructure_t& structureTo = containerTo.GetStructure();
+            const ChunkStructure_t& structureFrom = containerFrom.GetStructure();
+            if (structureTo == structureFrom)
+            {
+                structureTo.Plan.Node.RelocateForwardUnsafe(GetComponentDataFunction(containerTo),   firstNodeIndexTo,
+                                                            GetComponentDataFunction(containerFrom), firstNodeIndexFrom,
+                                                            nodeCount);
+                return;
+            }
+            for (const Size_t indexTo : structureTo.NodeComponentIndex)
+            {
+                const ComponentType_t& componentType = structureTo.GetComponentType(indexTo);
+                const Size_t indexFrom = structureFrom.GetComponentTypeIndexInChunkById(componentType.GetId());
+                if (indexFrom == -1)
+                    componentType.ConstructDataUnsafe(containerTo.GetComponentData(indexTo), firstNodeIndexTo, nodeCount);
+                else
+                    componentType.RelocateDataForwardUnsafe(containerTo.GetComponentData(indexTo),     firstNodeIndexTo,
+                                                            containerFrom.GetComponentData(indexFrom), firstNodeIndexFrom,
+                                                            nodeCount);
+            }
+            for (const Size_t indexFrom : structureFrom.NodeComponentIndex)
+            {
+                const ComponentType_t& componentType = structureFrom.GetComponentType(indexFrom);
+                if (structureTo.GetComponentTypeIndexInChunkById(componentType.GetId()) == -1)
+                    componentType.DestructDataUnsafe(containerFrom.GetComponentData(indexFrom), firstNodeIndexFrom, nodeCount);
+            }
+        }
+
+        /// <summary>
+        /// Reorder a range of nodes in a container so node (firstNodeIndex + i) ends up with the components 
+        /// node (firstNodeIndex + order[i]) had.
+        /// Each NodeComponent column is relocated through a scratch buffer, consecutive runs of order with a single relocate.
+        /// Notes:
+        ///     order must be a permutation of [0, nodeCount).
+        /// </summary>
+        template<typename TContainer>
+        static void PermuteAllNodeComponentsUnsafe(TContainer& container, const Size_t firstNodeIndex, const Size_t* const order, const NodeCountT<Size_t> nodeCount)
+        {
+            ni_assert(!container.IsNull());
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            if (nodeCount <= 1) return;
+
+            const ChunkStructure_t& chunkStructure = container.GetStructure();
+            Size_t scratchSize = 0;
+            Size_t scratchAlignment = 1;
+            for (const Size_t index : chunkStructure.NodeComponentIndex)
+            {
+                const ComponentType_t& componentType = chunkStructure.GetComponentType(index);
+                scratchSize = std::max<Size_t>(scratchSize, componentType.GetSize() * nodeCount);
+                scratchAlignment = std::max<Size_t>(scratchAlignment, componentType.GetAlignment());
+            }
+            if (scratchSize == 0) return;
+            void* const scratch = ni_alloc(scratchSize, scratchAlignment);
+            for (const Size_t index : chunkStructure.NodeComponentIndex)
+            {
+                const ComponentType_t& componentType = chunkStructure.GetComponentType(index);
+                void* const data = container.GetComponentData(index);
+                for (Size_t i = 0; i < nodeCount;)
+                {
+                    Size_t runCount = 1;
+                    while (i + runCount < nodeCount && order[i + runCount] == order[i] + runCount)
+                        ++runCount;
+                    componentType.RelocateDataForwardUnsafe(scratch, i, data, firstNodeIndex + order[i], runCount);
+                    i += runCount;
+                }
+                componentType.RelocateDataForwardUnsafe(data, firstNodeIndex, scratch, 0, nodeCount);
+            }
+            ni_free_dirty(scratch, scratchSize, scratchAlignment);
+        }
+
+        /// <summary>
+        /// A range of NodeCount sequential nodes relocated from FirstNodeIndexFrom to FirstNodeIndexTo in the same container.
+        /// </summary>
+        struct NodeRelocation
+        {
+            Size_t FirstNodeIndexTo;
+            Size_t FirstNodeIndexFrom;
+            Size_t NodeCount;
+        };
+
+        /// <summary>
+        /// Relocate multiple ranges of nodes in a container, one NodeComponent column at a time so each column
+        /// is streamed once through all ranges. Trivially relocatable columns, from the structure's operation plan,
+        /// take a single memmove per range; only the other columns go through their component type's relocate.
+        /// Notes:
+        ///     Ranges are relocated in order, each must not overlap forward and its destination must be destructed
+        ///     or already relocated, making this function unsafe.
+        /// </summary>
+        template<typename TContainer>
+        static void RelocateAllNodeComponentsUnsafe(TContainer& container, const NodeRelocation* const relocations, const Size_t relocationCount)
+        {
+            ni_assert(!container.IsNull());
+            ni_assert(relocationCount >= 0);
+            if (relocationCount == 0) return;
+
+            const auto& plan = container.GetStructure().Plan.Node;
+            for (const auto& step : plan.MemRelocateSteps)
+            {
+                uint8* const data = (uint8*)container.GetComponentData(step.ComponentIndex);
+                const std::size_t size = (std::size_t)step.Size;
+                for (Size_t i = 0; i < relocationCount; ++i)
+                {
+                    const NodeRelocation& relocation = relocations[i];
+                    std::memmove(data + relocation.FirstNodeIndexTo   * size,
+                                 data + relocation.FirstNodeIndexFrom * size,
+                                        relocation.NodeCount          * size);
+                }
+            }
+            for (const auto& step : plan.RelocateSteps)
+            {
+                void* const data = container.GetComponentData(step.ComponentIndex);
+                for (Size_t i = 0; i < relocationCount; ++i)
+                {
+                    const NodeRelocation& relocation = relocations[i];
+                    step.Move(data, relocation.FirstNodeIndexTo,
+                              data, relocation.FirstNodeIndexFrom, relocation.NodeCount);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Construct only the NodeComponents in a container by copying them from external arrays, one per component.
+        /// sources[i] is the array of nodeCount components for the component at index i in the chunk structure,
+        /// NodeComponents with a nullptr source are default constructed.
+        /// Notes:
+        ///     It can be called before index at (firstNodeIndex + nodeCount) is included by
+        ///     the container NodeCount, making this function unsafe.
+        /// </summary>
+        template<typename TContainer>
+        static void CopyConstructAllNodeComponentsFromUnsafe(TContainer& container, const Size_t firstNodeIndex,
+                                                             const void* const* const sources, const NodeCountT<Size_t> nodeCount)
+        {
+            ni_assert(!container.IsNull());
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(!!sources);
+
+            const ChunkStructure_t& chunkStructure = container.GetStructure();
+            for (const Size_t index : chunkStructure.NodeComponentIndex)
+            {
+                const ComponentType_t& componentType = chunkStructure.GetComponentType(index);
+                if (sources[index] != nullptr)
+                    componentType.CopyConstructDataFromUnsafe(container.GetComponentData(index), firstNodeIndex, sources[index], nodeCount);
+                else
+                    componentType.ConstructDataUnsafe(container.GetComponentData(index), firstNodeIndex, nodeCount);
+            }
+        }
+
+        /// <summary>
+        /// Construct only the NodeComponents in a container by moving them from external arrays, one per component.
+        /// sources[i] is the array of nodeCount components for the component at index i in the chunk structure,
+        /// NodeComponents with a nullptr source are default constructed.
+        /// Notes:
+        ///     It can be called before index at (firstNodeIndex + nodeCount) is included by
+        ///     the container NodeCount, making this function unsafe.
+        ///     Components in sources are left moved-from and must still be destructed by their owner.
+        /// </summary>
+        template<typename TContainer>
+        static void MoveConstructAllNodeComponentsFromUnsafe(TContainer& container, const Size_t firstNodeIndex,
+                                                             void* const* const sources, const NodeCountT<Size_t> nodeCount)
+        {
+            ni_assert(!container.IsNull());
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(!!sources);
+
+            const ChunkStructure_t& chunkStructure = container.GetStructure();
+            for (const Size_t index : chunkStructure.NodeComponentIndex)
             {
-                Size_t index = chunkStructure.ChunkComponentIndex[i];
-                const ComponentType_t* componentType = chunkStructure.Components[index];
-                void* componentDataTo = containerTo.GetComponentData(index);
-                void* componentDataFrom = containerFrom.GetComponentData(index);
-                componentType->MoveDataForwardUnsafe(componentDataTo,   firstChunkIndexTo,
-                                                     componentDataFrom, firstChunkIndexFrom, 
-                                                     chunkCount);
+                const ComponentType_t& componentType = chunkStructure.GetComponentType(index);
+                if (sources[index] != nullptr)
+                    componentType.MoveConstructDataFromUnsafe(container.GetComponentData(index), firstNodeIndex, sources[index], nodeCount);
+                else
+                    componentType.ConstructDataUnsafe(container.GetComponentData(index), firstNodeIndex, nodeCount);
+            }
+        }
+
+        /// <summary>
+        /// Construct only the NodeComponents in a container by copying them from an external array of nodeCount structures
+        /// of sourceStride bytes each. componentOffsets[i] is the byte offset in a structure of the component at index i
+        /// in the chunk structure, NodeComponents with a negative offset are default constructed.
+        /// Notes:
+        ///     It can be called before index at (firstNodeIndex + nodeCount) is included by
+        ///     the container NodeCount, making this function unsafe.
+        /// </summary>
+        template<typename TContainer>
+        static void CopyConstructAllNodeComponentsStridedFromUnsafe(TContainer& container, const Size_t firstNodeIndex,
+                                                                    const void* const source, const Size_t sourceStride, const Size_t* const componentOffsets,
+                                                                    const NodeCountT<Size_t> nodeCount)
+        {
+            ni_assert(!container.IsNull());
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(!!source);
+            ni_assert(!!componentOffsets);
+
+            const ChunkStructure_t& chunkStructure = container.GetStructure();
+            for (const Size_t index : chunkStructure.NodeComponentIndex)
+            {
+                const ComponentType_t& componentType = chunkStructure.GetComponentType(index);
+                if (componentOffsets[index] >= 0)
+                {
+                    ni_assert(componentOffsets[index] + componentType.GetSize() <= sourceStride);
+                    componentType.CopyConstructDataStridedFromUnsafe(container.GetComponentData(index), firstNodeIndex,
+                                                                     (const uint8*)source + componentOffsets[index], sourceStride, nodeCount);
+                }
+                else
+                    componentType.ConstructDataUnsafe(container.GetComponentData(index), firstNodeIndex, nodeCount);
             }
         }
 
@@ -307,19 +489,11 @@ namespace NiT
 
             void** const componentDataArrayTo = TContainer::GetInternalChunk(container).ComponentDataArray;
 
-            if (nodeCount == 0)
-            {
-                // TODO: Construct only ChunkComponents
-                //return;
-            }
             const ChunkStructure_t& chunkStructure = container.GetStructure();
-            Size_t componentCount = chunkStructure.GetComponentCount();
-            for (Size_t i = 0; i < componentCount; ++i)
-            {
-                const ComponentType_t& componentType = chunkStructure.GetComponentType(i);
-                componentDataArrayTo[i] = (void*)ni_alloc(componentType.GetSize(nodeCapacity, chunkCapacity), componentType.GetAlignment());
-                componentType.ConstructComponentUnsafe(componentDataArrayTo[i], firstNodeIndex, firstChunkIndex, nodeCount, chunkCount);
-            }
+            AllocateComponentDataUnsafe(chunkStructure, componentDataArrayTo, nodeCapacity, chunkCapacity);
+            const auto getData = GetComponentDataArrayFunction(componentDataArrayTo);
+            chunkStructure.Plan.Node. ConstructUnsafe(getData, firstNodeIndex,  nodeCount);
+            chunkStructure.Plan.Chunk.ConstructUnsafe(getData, firstChunkIndex, chunkCount);
         }
 
         /// <summary>
@@ -346,16 +520,11 @@ namespace NiT
             ni_assert(chunkCapacity >= chunkCount);
             void** const componentDataArrayTo = TContainerTo::GetInternalChunk(containerTo).ComponentDataArray;
             const ChunkStructure_t& chunkStructure = containerTo.GetStructure();
-            Size_t componentCount = chunkStructure.GetComponentCount();
-            for (Size_t i = 0; i < componentCount; ++i)
-            {
-                const ComponentType_t& componentType = chunkStructure.GetComponentType(i);
-                componentDataArrayTo[i] = (void*)ni_alloc(componentType.GetSize(nodeCapacity, chunkCapacity), componentType.GetAlignment());
-                componentType.CopyConstructComponentForwardUnsafe(
-                    componentDataArrayTo[i],           firstNodeIndexTo,   firstChunkIndexTo,
-                    containerFrom.GetComponentData(i), firstNodeIndexFrom, firstChunkIndexFrom, 
-                                                       nodeCount,          chunkCount);
-            }
+            AllocateComponentDataUnsafe(chunkStructure, componentDataArrayTo, nodeCapacity, chunkCapacity);
+            const auto getDataTo   = GetComponentDataArrayFunction(componentDataArrayTo);
+            const auto getDataFrom = GetComponentDataFunction(containerFrom);
+            chunkStructure.Plan.Node. CopyConstructUnsafe(getDataTo, firstNodeIndexTo,  getDataFrom, firstNodeIndexFrom,  nodeCount);
+            chunkStructure.Plan.Chunk.CopyConstructUnsafe(getDataTo, firstChunkIndexTo, getDataFrom, firstChunkIndexFrom, chunkCount);
         }
 
         /// <summary>
@@ -393,6 +562,37 @@ namespace NiT
             const auto chunkCapacityFrom = containerToReallocate.GetChunkCapacity();
             void** const componentDataArrayTo = TContainerTo::GetInternalChunk(containerToReallocate).ComponentDataArray;
             const ChunkStructure_t& structure = containerToReallocate.GetStructure();
+            TrackReallocatedMemory(structure, nodeCapacityTo, chunkCapacityTo, nodeCapacity, chunkCapacity);
+#ifdef NI_MEMORY_SINGLE_BLOCK
+            // The block layout depends on both capacities: reallocate it whenever either changes, even if its size stays the same.
+            if (nodeCapacity != nodeCapacityTo || chunkCapacity != chunkCapacityTo)
+            {
+                const Size_t blockAllocSize = structure.GetBlockSize(nodeCapacity,   chunkCapacity);
+                const Size_t blockFreeSize  = structure.GetBlockSize(nodeCapacityTo, chunkCapacityTo);
+                void* const blockOld = structure.GetBlock(componentDataArrayTo);
+                void* const blockNew = (void*)ni_alloc(blockAllocSize, structure.BlockAlignment);
+                const auto getDataNew  = GetBlockComponentDataFunction(structure, blockNew, nodeCapacity, chunkCapacity);
+                const auto getDataOld  = GetComponentDataArrayFunction(componentDataArrayTo);
+                const auto getDataFrom = GetComponentDataFunction(containerFrom);
+                structure.Plan.Node. CopyConstructUnsafe(getDataNew, firstNodeIndexTo,  getDataFrom, firstNodeIndexFrom,  nodeCountToCopy);
+                structure.Plan.Chunk.CopyConstructUnsafe(getDataNew, firstChunkIndexTo, getDataFrom, firstChunkIndexFrom, chunkCountToCopy);
+                structure.Plan.Node. DestructUnsafe(getDataOld, 0/*:firstNodeIndex*/,  nodeCountTo);
+                structure.Plan.Chunk.DestructUnsafe(getDataOld, 0/*:firstChunkIndex*/, chunkCountTo);
+                structure.SetBlockComponentDataArray(componentDataArrayTo, blockNew, nodeCapacity, chunkCapacity);
+                if (blockOld)
+                    ni_free_dirty(blockOld, blockFreeSize, structure.BlockAlignment);
+                return;
+            }
+            // Same capacities, the block is reused in place.
+            const auto componentCount = structure.GetComponentCount();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                structure.GetComponentType(i).CopyAssignComponentForwardUnsafe(
+                                componentDataArrayTo[i],           firstNodeIndexTo,   firstChunkIndexTo,
+                                containerFrom.GetComponentData(i), firstNodeIndexFrom, firstChunkIndexFrom,
+                                                                   nodeCountToCopy,    chunkCountToCopy);
+            }
+#else
             const auto componentCount = structure.GetComponentCount();
             for (Size_t i = 0; i < componentCount; ++i)
             {
@@ -415,17 +615,18 @@ namespace NiT
                     componentType.DestructComponentUnsafe(componentDataArrayTo[i], 
                                                           0/*:firstNodeIndex*/, 0/*:firstChunkIndex*/,
                                                           nodeCountTo,          chunkCountTo);
-                    ni_free_dirty(componentDataArrayTo[i], componentType.GetSize(nodeCapacityTo), componentType.GetAlignment());
+                    ni_free_dirty(componentDataArrayTo[i], componentType.GetSize(nodeCapacityTo, chunkCapacityTo), componentType.GetAlignment());
                     componentDataArrayTo[i] = dataNew;
                 }
             }
+#endif
         }
         
         /// <summary>
         /// Reallocate containerToReallocate to fit the nodes moved from containerFrom
         /// Notes:
         ///     containerToReallocate and containerFrom must have the same structure
-        ///     containerToReallocate CAN be the same as containerFrom 
+        ///     containerToReallocate CAN be the same as containerFrom, components are then relocated to the new memory.
         ///     Will destruct and free (or reuse) data from containerToReallocate.
         ///     Does not set NodeCapacity nor NodeCount on containerToReallocate.
         ///     nodeCountToMove must be less or equal to nodeCapacity.
@@ -459,6 +660,57 @@ namespace NiT
             const auto chunkCapacityFrom = containerToReallocate.GetChunkCapacity();
             void** const componentDataArrayTo = TContainerTo::GetInternalChunk(containerToReallocate).ComponentDataArray;
             const ChunkStructure_t& structure = containerToReallocate.GetStructure();
+            TrackReallocatedMemory(structure, nodeCapacityTo, chunkCapacityTo, nodeCapacity, chunkCapacity);
+            // When reallocating a container into itself, components are relocated instead of moved and destructed.
+            const bool isSameData = componentDataArrayTo == TContainerFrom::GetInternalChunk(containerFrom).ComponentDataArray;
+#ifdef NI_MEMORY_SINGLE_BLOCK
+            // The block layout depends on both capacities: reallocate it whenever either changes, even if its size stays the same.
+            if (nodeCapacity != nodeCapacityTo || chunkCapacity != chunkCapacityTo)
+            {
+                const Size_t blockAllocSize = structure.GetBlockSize(nodeCapacity,   chunkCapacity);
+                const Size_t blockFreeSize  = structure.GetBlockSize(nodeCapacityTo, chunkCapacityTo);
+                // containerFrom can be containerToReallocate, the ComponentDataArray is only replaced once all data are moved
+                void* const blockOld = structure.GetBlock(componentDataArrayTo);
+                void* const blockNew = (void*)ni_alloc(blockAllocSize, structure.BlockAlignment);
+                const auto getDataNew  = GetBlockComponentDataFunction(structure, blockNew, nodeCapacity, chunkCapacity);
+                const auto getDataOld  = GetComponentDataArrayFunction(componentDataArrayTo);
+                const auto getDataFrom = GetComponentDataFunction(containerFrom);
+                if (isSameData)
+                {
+                    structure.Plan.Node. RelocateForwardUnsafe(getDataNew, firstNodeIndexTo,  getDataFrom, firstNodeIndexFrom,  nodeCountToMove);
+                    structure.Plan.Chunk.RelocateForwardUnsafe(getDataNew, firstChunkIndexTo, getDataFrom, firstChunkIndexFrom, chunkCountToMove);
+                    // Destruct the old data left behind around the relocated range
+                    const Size_t endNodeIndexFrom  = firstNodeIndexFrom  + nodeCountToMove;
+                    const Size_t endChunkIndexFrom = firstChunkIndexFrom + chunkCountToMove;
+                    structure.Plan.Node. DestructUnsafe(getDataOld, 0, firstNodeIndexFrom);
+                    structure.Plan.Node. DestructUnsafe(getDataOld, endNodeIndexFrom, nodeCountTo - endNodeIndexFrom);
+                    structure.Plan.Chunk.DestructUnsafe(getDataOld, 0, firstChunkIndexFrom);
+                    structure.Plan.Chunk.DestructUnsafe(getDataOld, endChunkIndexFrom, chunkCountTo - endChunkIndexFrom);
+                }
+                else
+                {
+                    structure.Plan.Node. MoveConstructForwardUnsafe(getDataNew, firstNodeIndexTo,  getDataFrom, firstNodeIndexFrom,  nodeCountToMove);
+                    structure.Plan.Chunk.MoveConstructForwardUnsafe(getDataNew, firstChunkIndexTo, getDataFrom, firstChunkIndexFrom, chunkCountToMove);
+                    structure.Plan.Node. DestructUnsafe(getDataOld, 0/*:firstNodeIndex*/,  nodeCountTo);
+                    structure.Plan.Chunk.DestructUnsafe(getDataOld, 0/*:firstChunkIndex*/, chunkCountTo);
+                }
+                structure.SetBlockComponentDataArray(componentDataArrayTo, blockNew, nodeCapacity, chunkCapacity);
+                if (blockOld)
+                    ni_free_dirty(blockOld, blockFreeSize, structure.BlockAlignment);
+                return;
+            }
+            // Same capacities, the block is reused in place.
+            if (isSameData)
+                return;
+            const auto componentCount = structure.GetComponentCount();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                structure.GetComponentType(i).MoveAssignComponentForwardUnsafe(
+                                  componentDataArrayTo[i],           firstNodeIndexTo,   firstChunkIndexTo,
+                                  containerFrom.GetComponentData(i), firstNodeIndexFrom, firstChunkIndexFrom,
+                                                                     nodeCountToMove,    chunkCountToMove);
+            }
+#else
             const auto componentCount = structure.GetComponentCount();
             for (Size_t i = 0; i < componentCount; ++i)
             {
@@ -478,19 +730,196 @@ namespace NiT
                 else
                 {
                     void* const dataNew = (void*)ni_alloc(allocSize, componentType.GetAlignment());
-                    componentType.MoveConstructComponentForwardUnsafe(
-                                      dataNew,  firstNodeIndexTo,   firstChunkIndexTo,
-                                      dataFrom, firstNodeIndexFrom, firstChunkIndexFrom,
-                                                nodeCountToMove,    chunkCountToMove);
-                    componentType.DestructComponentUnsafe(
-                                      componentDataArrayTo[i], 0/*:firstNodeIndex*/, 0/*:firstChunkIndex*/,
-                                                               nodeCountTo,          chunkCountTo);
-                    ni_free_dirty(componentDataArrayTo[i], componentType.GetSize(nodeCapacityTo), componentType.GetAlignment());
+                    MoveToNewComponentDataUnsafe(componentType, isSameData,
+                                                 dataNew,                 firstNodeIndexTo,   firstChunkIndexTo,
+                                                 componentDataArrayTo[i], nodeCountTo,        chunkCountTo,
+                                                 dataFrom,                firstNodeIndexFrom, firstChunkIndexFrom,
+                                                                          nodeCountToMove,    chunkCountToMove);
+                    ni_free_dirty(componentDataArrayTo[i], componentType.GetSize(nodeCapacityTo, chunkCapacityTo), componentType.GetAlignment());
                     componentDataArrayTo[i] = dataNew;
                 }
             }
+#endif
+        }
+
+        /// <summary>
+        /// Move one component type's data of a container being reallocated to its newly allocated memory and destruct the old data.
+        /// If the data is moved from the container being reallocated, it is relocated and the old data left behind is destructed.
+        /// Otherwise it is move-constructed from dataFrom and all old data is destructed.
+        /// </summary>
+        static void MoveToNewComponentDataUnsafe(const ComponentType_t& componentType, const bool isSameData,
+                        void* const dataNew,  const               Size_t  firstNodeIndexTo,   const                Size_t  firstChunkIndexTo,
+                        void* const dataOld,  const NodeCountT   <Size_t> nodeCountOld,       const ChunkCountT   <Size_t> chunkCountOld,
+                        void* const dataFrom, const               Size_t  firstNodeIndexFrom, const                Size_t  firstChunkIndexFrom,
+                                              const NodeCountT   <Size_t> nodeCountToMove,    const ChunkCountT   <Size_t> chunkCountToMove)
+        {
+            if (isSameData)
+            {
+                componentType.RelocateComponentForwardUnsafe(
+                                  dataNew,  firstNodeIndexTo,   firstChunkIndexTo,
+                                  dataFrom, firstNodeIndexFrom, firstChunkIndexFrom,
+                                            nodeCountToMove,    chunkCountToMove);
+                const Size_t firstMovedIndex = componentType.GetComponentIndex(firstNodeIndexFrom, firstChunkIndexFrom);
+                const Size_t endMovedIndex   = firstMovedIndex + componentType.GetComponentCount(nodeCountToMove, chunkCountToMove);
+                const Size_t oldCount        = componentType.GetComponentCount(nodeCountOld, chunkCountOld);
+                componentType.DestructDataUnsafe(dataOld, 0, firstMovedIndex);
+                componentType.DestructDataUnsafe(dataOld, endMovedIndex, oldCount - endMovedIndex);
+            }
+            else
+            {
+                componentType.MoveConstructComponentForwardUnsafe(
+                                  dataNew,  firstNodeIndexTo,   firstChunkIndexTo,
+                                  dataFrom, firstNodeIndexFrom, firstChunkIndexFrom,
+                                            nodeCountToMove,    chunkCountToMove);
+                componentType.DestructComponentUnsafe(
+                                  dataOld, 0/*:firstNodeIndex*/, 0/*:firstChunkIndex*/,
+                                           nodeCountOld,         chunkCountOld);
+            }
+        }
+
+        /// <summary>
+        /// Get a function returning a component type's data in a container, used to execute the structure's operation plan.
+        /// </summary>
+        template<typename TContainer>
+        static auto GetComponentDataFunction(TContainer& container)
+        {
+            return [&container](const Size_t index) { return container.GetComponentData(index); };
+        }
+
+        /// <summary>
+        /// Get a function returning a component type's data in a ComponentDataArray.
+        /// </summary>
+        static auto GetComponentDataArrayFunction(void* const* const componentDataArray)
+        {
+            return [componentDataArray](const Size_t index) { return componentDataArray[index]; };
+        }
+
+        /// <summary>
+        /// Get a function returning a component type's data in a single memory block not yet set in a ComponentDataArray.
+        /// </summary>
+        static auto GetBlockComponentDataFunction(const ChunkStructure_t& structure, void* const block,
+                                                  const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)
+        {
+            return [&structure, block, nodeCapacity, chunkCapacity](const Size_t index) 
+            { 
+                return structure.GetBlockComponentData(block, index, nodeCapacity, chunkCapacity); 
+            };
+        }
+
+        /// <summary>
+        /// Allocate all components' data of a ComponentDataArray for nodeCapacity nodes and chunkCapacity chunks.
+        /// Allocate a single memory block under NI_MEMORY_SINGLE_BLOCK, otherwise one per component type.
+        /// </summary>
+        static void AllocateComponentDataUnsafe(const ChunkStructure_t& structure, void** const componentDataArray,
+                                                const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)
+        {
+#ifdef NI_MEMORY_SINGLE_BLOCK
+            AllocateBlockUnsafe(structure, componentDataArray, nodeCapacity, chunkCapacity);
+#else
+            const Size_t componentCount = structure.GetComponentCount();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                const ComponentType_t& componentType = structure.GetComponentType(i);
+                componentDataArray[i] = (void*)ni_alloc(componentType.GetSize(nodeCapacity, chunkCapacity), componentType.GetAlignment());
+            }
+#endif
+            TrackMemory(structure, nodeCapacity, chunkCapacity, true);
         }
 
+        /// <summary>
+        /// Attribute the memory of all components' data for nodeCapacity nodes and chunkCapacity chunks
+        /// to the structure and each of its component types. Does nothing without NI_MEMORY_STATS.
+        /// </summary>
+        static void TrackMemory(const ChunkStructure_t& structure,
+                                const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity,
+                                const bool allocated)
+        {
+#ifdef NI_MEMORY_STATS
+            int64 structureSize = 0;
+            const Size_t componentCount = structure.GetComponentCount();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                const ComponentType_t& componentType = structure.GetComponentType(i);
+                const int64 size = componentType.GetSize(nodeCapacity, chunkCapacity);
+                structureSize += size;
+                if (allocated)
+                    componentType.Memory.Add(size);
+                else
+                    componentType.Memory.Remove(size);
+            }
+            if (allocated)
+                structure.Memory.Add(structureSize);
+            else
+                structure.Memory.Remove(structureSize);
+#endif
+        }
+
+        /// <summary>
+        /// Attribute the memory of a reallocation from the old capacities to the new ones, see ReallocateCopyAllComponentsForwardUnsafe.
+        /// Memory reused in place only has its size adjusted and is not counted as a new allocation. Does nothing without NI_MEMORY_STATS.
+        /// </summary>
+        static void TrackReallocatedMemory(const ChunkStructure_t& structure,
+                                           const NodeCapacityT<Size_t> nodeCapacityOld, const ChunkCapacityT<Size_t> chunkCapacityOld,
+                                           const NodeCapacityT<Size_t> nodeCapacity,    const ChunkCapacityT<Size_t> chunkCapacity)
+        {
+#ifdef NI_MEMORY_STATS
+#ifdef NI_MEMORY_SINGLE_BLOCK
+            // The block is reused in place when both capacities are unchanged, otherwise a new block is allocated.
+            if (nodeCapacity == nodeCapacityOld && chunkCapacity == chunkCapacityOld)
+                return;
+            TrackMemory(structure, nodeCapacityOld, chunkCapacityOld, false);
+            TrackMemory(structure, nodeCapacity,    chunkCapacity,    true);
+#else
+            // Each component type's data is reused in place when its size is unchanged.
+            int64 structureSizeOld = 0;
+            int64 structureSize = 0;
+            const Size_t componentCount = structure.GetComponentCount();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                const ComponentType_t& componentType = structure.GetComponentType(i);
+                const int64 sizeOld = componentType.GetSize(nodeCapacityOld, chunkCapacityOld);
+                const int64 size    = componentType.GetSize(nodeCapacity,    chunkCapacity);
+                structureSizeOld += sizeOld;
+                structureSize    += size;
+                if (size == sizeOld)
+                    continue;
+                componentType.Memory.Remove(sizeOld);
+                componentType.Memory.Add(size);
+            }
+            structure.Memory.Resize(structureSizeOld, structureSize);
+#endif
+#endif
+        }
+
+#ifdef NI_MEMORY_SINGLE_BLOCK
+        /// <summary>
+        /// Allocate a single memory block for all components' data and set the ComponentDataArray void* values to point into it.
+        /// </summary>
+        static void AllocateBlockUnsafe(const ChunkStructure_t& structure, void** const componentDataArray,
+                                        const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)
+        {
+            if (structure.GetComponentCount() == 0) return;
+            void* const block = (void*)ni_alloc(structure.GetBlockSize(nodeCapacity, chunkCapacity), structure.BlockAlignment);
+            structure.SetBlockComponentDataArray(componentDataArray, block, nodeCapacity, chunkCapacity);
+        }
+
+        /// <summary>
+        /// Free the single memory block a ComponentDataArray was allocated with AllocateBlockUnsafe.
+        /// </summary>
+        static void FreeBlockUnsafe(const ChunkStructure_t& structure, void** const componentDataArray,
+                                    const NodeCapacityT<Size_t> nodeCapacity, const ChunkCapacityT<Size_t> chunkCapacity)
+        {
+            void* const block = structure.GetBlock(componentDataArray);
+            if (block == nullptr) return;
+            ni_free_dirty(block, structure.GetBlockSize(nodeCapacity, chunkCapacity), structure.BlockAlignment);
+#ifdef NI_MEMORYCLEANUP
+            const Size_t componentCount = structure.GetComponentCount();
+            for (Size_t i = 0; i < componentCount; ++i)
+                componentDataArray[i] = nullptr;
+#endif
+        }
+#endif
+
         template<typename TContainerA, typename TContainerB>
         static bool IsSameStructure(const TContainerA& a, const TContainerB& b) { return a.GetStructure() == b.GetStructure(); }
         template<typename TContainerA, typename TContainerB>
@@ -0,0 +1,432 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Components.h"
+
+namespace NiT
+{
+    template<typename TChunkStructure>
+    struct Container;
+
+    template<typename TChunkStructure>
+    struct NodeHandleTableT;
+
+    /// <summary>
+    /// Stable reference to a node that survives the node being moved inside its container or migrated to another container.
+    /// Resolve it with the NodeHandleTable that created it. A handle of a removed node never resolves again,
+    /// even when its slot in the table is reused, since the slot's generation changed.
+    /// </summary>
+    template<typename TSize>
+    struct NodeHandleT
+    {
+    public:
+        using Self_t = NodeHandleT<TSize>;
+        using Size_t = TSize;
+
+    public:
+        /// <summary>
+        /// Index of the slot in the NodeHandleTable or -1 for a null handle.
+        /// </summary>
+        Size_t Slot = -1;
+
+        /// <summary>
+        /// Generation of the slot when the handle was created.
+        /// </summary>
+        uint32 Generation = 0;
+
+        bool IsNull()const { return Slot < 0; }
+        bool operator==(const Self_t& o)const { return Slot == o.Slot && Generation == o.Generation; }
+        bool operator!=(const Self_t& o)const { return !(*this == o); }
+    };
+
+    /// <summary>
+    /// Container and index of a node resolved from a NodeHandle.
+    /// </summary>
+    template<typename TChunkStructure>
+    struct NodeLocationT
+    {
+    public:
+        using Self_t = NodeLocationT<TChunkStructure>;
+        using Size_t = typename TChunkStructure::Size_t;
+        using Container_t = NiT::Container<TChunkStructure>;
+
+    public:
+        /// <summary>
+        /// Container holding the node or nullptr if the handle did not resolve.
+        /// </summary>
+        Container_t* Container = nullptr;
+        Size_t NodeIndex = -1;
+
+        bool IsNull()const { return Container == nullptr; }
+
+        /// <summary>
+        /// Get the container as the type it was when the node was added to the table or last moved.
+        /// </summary>
+        template<typename TContainer>
+        TContainer* GetContainer()const { return static_cast<TContainer*>(Container); }
+    };
+
+    /// <summary>
+    /// Add to a ChunkStructure for its nodes to be referenced by NodeHandles.
+    /// Holds the slot of the node in the chunk's NodeHandleTable, -1 until a handle is created for the node.
+    /// </summary>
+    template<typename TSize>
+    struct CoNodeHandleT : public NodeComponent
+    {
+    public:
+        using Self_t = CoNodeHandleT<TSize>;
+        using Base_t = NodeComponent;
+        using Size_t = TSize;
+
+    public:
+        Size_t Slot = -1;
+    };
+
+    /// <summary>
+    /// NodeHandleTable the handles of a chunk's nodes are created in.
+    /// Set by the first handle created in the chunk or by the first node migrated in with a handle.
+    /// </summary>
+    template<typename TChunkStructure>
+    struct CoNodeHandleTableT : public ChunkComponent
+    {
+    public:
+        using Self_t = CoNodeHandleTableT<TChunkStructure>;
+        using Base_t = ChunkComponent;
+        using Size_t = typename TChunkStructure::Size_t;
+
+    public:
+        NodeHandleTableT<TChunkStructure>* Table = nullptr;
+    };
+
+    /// <summary>
+    /// Indirection table from NodeHandles to the current container and index of their node.
+    /// Resolving a handle is a single slot load and a generation check.
+    /// Bucket containers update the slots of all nodes they move, in bulk, when nodes are removed or migrated,
+    /// provided their ChunkStructure has both CoNodeHandle and CoNodeHandleTable. Growing a Bunch does not move
+    /// its nodes to other indices and needs no update.
+    /// Notes:
+    ///     Containers must stay at the same address while their nodes have handles, ex.: chunks owned by a registry.
+    ///     Destroy the handles of a container's nodes, or Clear it, before deleting it.
+    ///     All containers of the table share the ChunkStructure type TChunkStructure, so slots keep a typed pointer to their Container base.
+    /// </summary>
+    template<typename TChunkStructure>
+    struct NodeHandleTableT
+    {
+    public:
+        using Self_t = NodeHandleTableT<TChunkStructure>;
+        using Size_t = typename TChunkStructure::Size_t;
+        using Container_t = Container<TChunkStructure>;
+        using NodeHandle_t = NodeHandleT<Size_t>;
+        using NodeLocation_t = NodeLocationT<TChunkStructure>;
+        using CoNodeHandle_t = CoNodeHandleT<Size_t>;
+        using CoNodeHandleTable_t = CoNodeHandleTableT<TChunkStructure>;
+
+    protected:
+        struct SlotData
+        {
+            /// <summary>
+            /// Container holding the node or nullptr for a free slot.
+            /// </summary>
+            Container_t* Container;
+
+            /// <summary>
+            /// Index of the node in Container, or index of the next free slot for a free slot.
+            /// </summary>
+            Size_t NodeIndex;
+
+            uint32 Generation;
+        };
+
+        std_vector<SlotData> Slots;
+        Size_t FirstFreeSlot = -1;
+        Size_t HandleCount = 0;
+
+    public:
+        NodeHandleTableT() = default;
+        NodeHandleTableT(const Self_t&) = delete;
+        Self_t& operator=(const Self_t&) = delete;
+
+        Size_t GetHandleCount()const { return HandleCount; }
+
+        /// <summary>
+        /// Get the handle of a node, creating it if the node has none yet.
+        /// The container's ChunkStructure must have CoNodeHandle and CoNodeHandleTable.
+        /// </summary>
+        template<typename TContainer>
+        NodeHandle_t Create(TContainer& container, const Size_t nodeIndex)
+        {
+            NodeHandle_t handle;
+            CreateRange(container, nodeIndex, NodeCountT<Size_t>::V_1(), &handle);
+            return handle;
+        }
+
+        /// <summary>
+        /// Get the handles of a range of nodes, creating them for nodes having none yet.
+        /// </summary>
+        template<typename TContainer>
+        void CreateRange(TContainer& container, const Size_t firstNodeIndex, const NodeCountT<Size_t> nodeCount, NodeHandle_t* const outHandles)
+        {
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(firstNodeIndex + nodeCount <= container.GetNodeCount());
+            CoNodeHandle_t* const nodeHandles = container.template GetComponentData<CoNodeHandle_t>();
+            CoNodeHandleTable_t* const chunkTable = container.template GetComponentData<CoNodeHandleTable_t>();
+            ni_assertf(nodeHandles != nullptr && chunkTable != nullptr, TEXT("NodeHandles require CoNodeHandle and CoNodeHandleTable in the chunk structure."));
+            if (chunkTable->Table == nullptr)
+                chunkTable->Table = this;
+            ni_assertf(chunkTable->Table == this, TEXT("The chunk's nodes have handles in another NodeHandleTable."));
+
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                const Size_t nodeIndex = firstNodeIndex + i;
+                Size_t& slot = nodeHandles[nodeIndex].Slot;
+                if (slot < 0)
+                {
+                    slot = AllocateSlot();
+                    Slots[slot].Container = &container;
+                    Slots[slot].NodeIndex = nodeIndex;
+                }
+                outHandles[i] = NodeHandle_t{ slot, Slots[slot].Generation };
+            }
+        }
+
+        /// <summary>
+        /// Destroy the handle of a node while keeping the node. All copies of the handle stop resolving.
+        /// TContainer must be the type of the container holding the node.
+        /// </summary>
+        template<typename TContainer>
+        void Destroy(const NodeHandle_t handle)
+        {
+            const NodeLocation_t location = Resolve(handle);
+            if (location.IsNull())
+                return;
+            TContainer& container = *location.template GetContainer<TContainer>();
+            container.template GetComponentData<CoNodeHandle_t>()[location.NodeIndex].Slot = -1;
+            FreeSlot(handle.Slot);
+        }
+
+        bool IsValid(const NodeHandle_t handle)const
+        {
+            return handle.Slot >= 0 && handle.Slot < (Size_t)Slots.size() && Slots[handle.Slot].Generation == handle.Generation;
+        }
+
+        /// <summary>
+        /// Get the current container and index of a handle's node, or a null location if the node was removed.
+        /// </summary>
+        NodeLocation_t Resolve(const NodeHandle_t handle)const
+        {
+            if (!IsValid(handle))
+                return NodeLocation_t();
+            const SlotData& slot = Slots[handle.Slot];
+            return NodeLocation_t{ slot.Container, slot.NodeIndex };
+        }
+
+        /// <summary>
+        /// Resolve many handles at once, prefetching the slots of handles NI_NODE_HANDLE_PREFETCH_DISTANCE ahead.
+        /// </summary>
+        void ResolveBatch(const NodeHandle_t* const handles, const Size_t count, NodeLocation_t* const outLocations)const
+        {
+            const Size_t slotCount = (Size_t)Slots.size();
+            for (Size_t i = 0; i < count; ++i)
+            {
+                if (i + NI_NODE_HANDLE_PREFETCH_DISTANCE < count)
+                {
+                    const Size_t aheadSlot = handles[i + NI_NODE_HANDLE_PREFETCH_DISTANCE].Slot;
+                    if (aheadSlot >= 0 && aheadSlot < slotCount)
+                        ni_prefetch(&Slots[aheadSlot]);
+                }
+                outLocations[i] = Resolve(handles[i]);
+            }
+        }
+
+        /// <summary>
+        /// Call function(handleIndex, location, component) for each handle resolving to a node, where component is the node's TComponent.
+        /// Prefetches the slots of handles 2 * NI_NODE_HANDLE_PREFETCH_DISTANCE ahead and the TComponent of the nodes of handles
+        /// NI_NODE_HANDLE_PREFETCH_DISTANCE ahead, so each component is in cache when function reads it.
+        /// TContainer must be the type of the containers holding the nodes and their structure must have TComponent.
+        /// </summary>
+        template<typename TContainer, typename TComponent, typename TFunction>
+        void ForEachResolved(const NodeHandle_t* const handles, const Size_t count, TFunction&& function)const
+        {
+            const Size_t slotCount = (Size_t)Slots.size();
+            for (Size_t i = 0; i < count; ++i)
+            {
+                if (i + 2 * NI_NODE_HANDLE_PREFETCH_DISTANCE < count)
+                {
+                    const Size_t aheadSlot = handles[i + 2 * NI_NODE_HANDLE_PREFETCH_DISTANCE].Slot;
+                    if (aheadSlot >= 0 && aheadSlot < slotCount)
+                        ni_prefetch(&Slots[aheadSlot]);
+                }
+                if (i + NI_NODE_HANDLE_PREFETCH_DISTANCE < count)
+                {
+                    const NodeLocation_t ahead = Resolve(handles[i + NI_NODE_HANDLE_PREFETCH_DISTANCE]);
+                    if (!ahead.IsNull())
+                    {
+                        const TComponent* const aheadComponent = GetComponent<TContainer, TComponent>(ahead);
+                        ni_prefetch(aheadComponent);
+                    }
+                }
+                const NodeLocation_t location = Resolve(handles[i]);
+                if (!location.IsNull())
+                    function(i, location, *GetComponent<TContainer, TComponent>(location));
+            }
+        }
+
+    public:
+        /// <summary>
+        /// Update the slots of a range of nodes after they were moved to their current index in container.
+        /// Called by containers moving nodes around, does nothing if the container's structure does not support handles.
+        /// </summary>
+        template<typename TContainer>
+        static void UpdateNodes(TContainer& container, const Size_t firstNodeIndex, const Size_t nodeCount)
+        {
+            CoNodeHandle_t* nodeHandles;
+            Self_t* const table = GetTable(container, nodeHandles);
+            if (table == nullptr)
+                return;
+            for (Size_t i = firstNodeIndex; i < firstNodeIndex + nodeCount; ++i)
+            {
+                const Size_t slot = nodeHandles[i].Slot;
+                if (slot < 0)
+                    continue;
+                table->Slots[slot].Container = &container;
+                table->Slots[slot].NodeIndex = i;
+            }
+        }
+
+        /// <summary>
+        /// Free the slots of a range of nodes about to be destructed, so their handles stop resolving.
+        /// Called by containers removing nodes, does nothing if the container's structure does not support handles.
+        /// </summary>
+        template<typename TContainer>
+        static void ReleaseNodes(TContainer& container, const Size_t firstNodeIndex, const Size_t nodeCount)
+        {
+            CoNodeHandle_t* nodeHandles;
+            Self_t* const table = GetTable(container, nodeHandles);
+            if (table == nullptr)
+                return;
+            for (Size_t i = firstNodeIndex; i < firstNodeIndex + nodeCount; ++i)
+            {
+                if (nodeHandles[i].Slot < 0)
+                    continue;
+                table->FreeSlot(nodeHandles[i].Slot);
+                nodeHandles[i].Slot = -1;
+            }
+        }
+
+        /// <summary>
+        /// Clear the handle slot of a range of nodes constructed from external data, so they do not share the handles
+        /// of the nodes their CoNodeHandle was copied or moved from. Does nothing if the container's structure has no CoNodeHandle.
+        /// </summary>
+        template<typename TContainer>
+        static void DetachNodes(TContainer& container, const Size_t firstNodeIndex, const Size_t nodeCount)
+        {
+            if (!container.GetStructure().GetMask().template Test<CoNodeHandle_t>())
+                return;
+            CoNodeHandle_t* const nodeHandles = container.template GetComponentData<CoNodeHandle_t>();
+            for (Size_t i = firstNodeIndex; i < firstNodeIndex + nodeCount; ++i)
+                nodeHandles[i].Slot = -1;
+        }
+
+        /// <summary>
+        /// Clear the handle slots of all nodes and the table of all chunks of a container whose data was copied from another container,
+        /// so the copy's nodes have no handle instead of sharing the slots of the nodes they were copied from.
+        /// Does nothing if the container's structure does not support handles.
+        /// </summary>
+        template<typename TContainer>
+        static void DetachCopy(TContainer& container, const NodeCountT<Size_t> nodeCount, const ChunkCountT<Size_t> chunkCount)
+        {
+            if (!HasNodeHandles(container))
+                return;
+            const auto& chunkStructure = container.GetStructure();
+            CoNodeHandle_t* const nodeHandles = (CoNodeHandle_t*)container.GetComponentData(chunkStructure.template GetComponentTypeIndexInChunk<CoNodeHandle_t>());
+            for (Size_t i = 0; i < nodeCount; ++i)
+                nodeHandles[i].Slot = -1;
+            CoNodeHandleTable_t* const chunkTables = (CoNodeHandleTable_t*)container.GetComponentData(chunkStructure.template GetComponentTypeIndexInChunk<CoNodeHandleTable_t>());
+            for (Size_t i = 0; i < chunkCount; ++i)
+                chunkTables[i].Table = nullptr;
+        }
+
+        /// <summary>
+        /// If the container's structure supports handles, i.e. has both CoNodeHandle and CoNodeHandleTable.
+        /// Only tests the bits of the structure's component mask, so containers check it once before updating slots.
+        /// </summary>
+        template<typename TContainer>
+        static bool HasNodeHandles(const TContainer& container)
+        {
+            const auto& mask = container.GetStructure().GetMask();
+            return mask.template Test<CoNodeHandle_t>() && mask.template Test<CoNodeHandleTable_t>();
+        }
+
+        /// <summary>
+        /// Prepare migrating a range of nodes between containers. The destination adopts the source's table
+        /// if it has none yet, or the nodes' handles are released if the destination does not support handles.
+        /// Call UpdateNodes on the destination range once the nodes are migrated.
+        /// </summary>
+        template<typename TContainerTo, typename TContainerFrom>
+        static void PrepareMigration(TContainerTo& containerTo, TContainerFrom& containerFrom, const Size_t firstNodeIndexFrom, const Size_t nodeCount)
+        {
+            CoNodeHandle_t* nodeHandlesFrom;
+            Self_t* const table = GetTable(containerFrom, nodeHandlesFrom);
+            if (table == nullptr)
+                return;
+            if (!HasNodeHandles(containerTo))
+            {
+                ReleaseNodes(containerFrom, firstNodeIndexFrom, nodeCount);
+                return;
+            }
+            CoNodeHandleTable_t* const chunkTableTo = containerTo.template GetComponentData<CoNodeHandleTable_t>();
+            if (chunkTableTo->Table == nullptr)
+                chunkTableTo->Table = table;
+            ni_assertf(chunkTableTo->Table == table, TEXT("Cannot migrate nodes with handles between chunks of different NodeHandleTables."));
+        }
+
+    protected:
+        template<typename TContainer, typename TComponent>
+        static TComponent* GetComponent(const NodeLocation_t location)
+        {
+            TComponent* const components = location.template GetContainer<TContainer>()->template GetComponentData<TComponent>();
+            ni_assert(components != nullptr);
+            return components + location.NodeIndex;
+        }
+
+        /// <summary>
+        /// Get the table of a container's nodes and their CoNodeHandle column, or nullptr if the structure does not support handles
+        /// or no handle was created in the container yet.
+        /// </summary>
+        template<typename TContainer>
+        static Self_t* GetTable(TContainer& container, CoNodeHandle_t*& outNodeHandles)
+        {
+            if (!HasNodeHandles(container))
+                return nullptr;
+            CoNodeHandleTable_t* const chunkTable = container.template GetComponentData<CoNodeHandleTable_t>();
+            if (chunkTable->Table == nullptr)
+                return nullptr;
+            outNodeHandles = container.template GetComponentData<CoNodeHandle_t>();
+            return chunkTable->Table;
+        }
+
+        Size_t AllocateSlot()
+        {
+            ++HandleCount;
+            if (FirstFreeSlot >= 0)
+            {
+                const Size_t slot = FirstFreeSlot;
+                FirstFreeSlot = Slots[slot].NodeIndex;
+                return slot;
+            }
+            Slots.push_back(SlotData{ nullptr, -1, 0 });
+            return (Size_t)Slots.size() - 1;
+        }
+
+        void FreeSlot(const Size_t slot)
+        {
+            --HandleCount;
+            Slots[slot].Container = nullptr;
+            Slots[slot].NodeIndex = FirstFreeSlot;
+            ++Slots[slot].Generation;
+            FirstFreeSlot = slot;
+        }
+    };
+}
@@ -0,0 +1,215 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include <thread>
+#include <exception>
+#include <condition_variable>
+
+// Bytes of node component data in each slice when running an algorithm on a single chunk from multiple threads without a set Grain.
+#ifndef NI_PARALLEL_SLICE_BYTES
+#   define NI_PARALLEL_SLICE_BYTES 32768
+#endif
+
+namespace NiT
+{
+    /// <summary>
+    /// Execution policy passed to Algorithm::Run / TryRun to split the work across threads.
+    /// </summary>
+    struct ParallelPolicy
+    {
+    public:
+        /// <summary>
+        /// Number of threads working on a run, including the calling thread.
+        /// 0 uses std::thread::hardware_concurrency().
+        /// </summary>
+        uint32 ThreadCount;
+
+        /// <summary>
+        /// Number of work items a thread claims at once. 0 splits the work evenly in 4 ranges per thread.
+        /// Work items are chunk elements when running on arrays and nodes when running on a single chunk.
+        /// </summary>
+        std::size_t Grain;
+
+    public:
+        ParallelPolicy(const uint32 threadCount = 0, const std::size_t grain = 0)
+            : ThreadCount(threadCount)
+            , Grain(grain)
+        {
+        }
+
+        uint32 GetThreadCount()const
+        {
+            if (ThreadCount > 0)
+                return ThreadCount;
+            return std::max<uint32>(1, std::thread::hardware_concurrency());
+        }
+
+        /// <summary>
+        /// Get the number of work items per range for a run of count work items.
+        /// </summary>
+        std::size_t GetGrain(const std::size_t count)const
+        {
+            if (Grain > 0)
+                return Grain;
+            const std::size_t rangeCount = (std::size_t)GetThreadCount() * 4;
+            return std::max<std::size_t>(1, (count + rangeCount - 1) / rangeCount);
+        }
+    };
+
+    /// <summary>
+    /// Persistent pool of worker threads helping the calling thread of ParallelFor.
+    /// Workers are started the first time they are needed and then wait for the next run instead of being joined,
+    /// so running on small containers or once per tree level does not pay for creating threads.
+    /// Notes:
+    ///     A single run at a time uses the workers, TryRun returns false while another one is in progress,
+    ///     including when called from inside a run.
+    /// </summary>
+    struct ParallelWorkers
+    {
+    protected:
+        using FnWork = void(*)(void*);
+
+        std_vector<std::thread> Threads;
+        std::mutex Mutex;
+        std::condition_variable WorkAvailable;
+        std::condition_variable WorkDone;
+        std::atomic<bool> IsRunning = false;
+        bool IsStopping = false;
+        FnWork Work = nullptr;
+        void* WorkContext = nullptr;
+        /// <summary>
+        /// Number of workers still to join the current run.
+        /// </summary>
+        uint32 PendingWorkerCount = 0;
+        /// <summary>
+        /// Number of workers that joined the current run or will, and did not return from it yet.
+        /// </summary>
+        uint32 ActiveWorkerCount = 0;
+
+    public:
+        static ParallelWorkers& Get()
+        {
+            static ParallelWorkers instance;
+            return instance;
+        }
+
+        ParallelWorkers() = default;
+        ParallelWorkers(const ParallelWorkers&) = delete;
+        ParallelWorkers& operator=(const ParallelWorkers&) = delete;
+
+        ~ParallelWorkers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                IsStopping = true;
+            }
+            WorkAvailable.notify_all();
+            for (std::thread& thread : Threads)
+                thread.join();
+        }
+
+        /// <summary>
+        /// Call work() on the calling thread and on workerCount workers, and return once all calls returned.
+        /// work is called concurrently and possibly more than once by the same worker, it must return once there is nothing left to do.
+        /// Returns false without calling work if another run is in progress.
+        /// </summary>
+        template<typename TWork>
+        bool TryRun(const uint32 workerCount, TWork& work)
+        {
+            bool expected = false;
+            if (!IsRunning.compare_exchange_strong(expected, true))
+                return false;
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                while (Threads.size() < workerCount)
+                    Threads.emplace_back([this]() { WorkerLoop(); });
+                Work = [](void* context) { (*(TWork*)context)(); };
+                WorkContext = &work;
+                PendingWorkerCount = workerCount;
+                ActiveWorkerCount = workerCount;
+            }
+            WorkAvailable.notify_all();
+            work();
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                WorkDone.wait(lock, [this]() { return ActiveWorkerCount == 0; });
+                Work = nullptr;
+                WorkContext = nullptr;
+            }
+            IsRunning.store(false);
+            return true;
+        }
+
+    protected:
+        void WorkerLoop()
+        {
+            std::unique_lock<std::mutex> lock(Mutex);
+            for (;;)
+            {
+                WorkAvailable.wait(lock, [this]() { return IsStopping || PendingWorkerCount > 0; });
+                if (IsStopping)
+                    return;
+                --PendingWorkerCount;
+                const FnWork work = Work;
+                void* const context = WorkContext;
+                lock.unlock();
+                work(context);
+                lock.lock();
+                if (--ActiveWorkerCount == 0)
+                    WorkDone.notify_one();
+            }
+        }
+    };
+
+    /// <summary>
+    /// Call function(firstIndex, count) on consecutive ranges of [0, count) from multiple threads.
+    /// Threads claim the next range from a shared atomic cursor as soon as they are done with their current one,
+    /// so faster threads take over the remaining work of slower ones.
+    /// The calling thread works too, helped by threads of ParallelWorkers, and returns once all ranges are done.
+    /// When ParallelWorkers is busy with another run, e.g. for a ParallelFor called from inside another, the calling thread does all ranges.
+    /// The first exception thrown by function is rethrown on the calling thread.
+    /// </summary>
+    template<typename TSize, typename TFunction>
+    void ParallelFor(const ParallelPolicy& policy, const TSize count, TFunction function)
+    {
+        if (count <= 0)
+            return;
+        const TSize grain = (TSize)policy.GetGrain((std::size_t)count);
+        const TSize rangeCount = (count + grain - 1) / grain;
+        const uint32 threadCount = (uint32)std::min<std::size_t>(policy.GetThreadCount(), (std::size_t)rangeCount);
+        if (threadCount <= 1)
+        {
+            function((TSize)0, count);
+            return;
+        }
+
+        std::atomic<TSize> nextRange(0);
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+        auto work = [&]()
+        {
+            try
+            {
+                for (TSize range = nextRange.fetch_add(1); range < rangeCount; range = nextRange.fetch_add(1))
+                {
+                    const TSize firstIndex = range * grain;
+                    function(firstIndex, std::min<TSize>(grain, count - firstIndex));
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception)
+                    exception = std::current_exception();
+                nextRange.store(rangeCount);
+            }
+        };
+
+        if (!ParallelWorkers::Get().TryRun(threadCount - 1, work))
+            work();
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,211 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Pipeline.h"
+#include "Parallel.h"
+#include <atomic>
+#include "ComponentAccess.h"
+#include "routing\AlgorithmCollectAccess.h"
+
+namespace NiT
+{
+    template<typename TSize>
+    struct PipelineRequirementCollectAccess;
+
+    template<typename TContainer, typename TSize>
+    struct PipelineRequirementRunAlgorithm;
+
+    /// <summary>
+    /// Extend this template struct instead of PipelineT to run the pipeline's algorithms concurrently.
+    /// The component types each algorithm reads and writes are collected from their Requirements and ordered in a
+    /// dependency graph: an algorithm depends on every previous algorithm it conflicts with, writing a component type
+    /// the other reads or writes. Algorithms are grouped in levels where no algorithm depends on another of the same level.
+    /// RunParallel runs each level's algorithms concurrently on the same container and waits for a level to complete
+    /// before starting the next.
+    /// </summary>
+    /// <typeparam name="TDerivedPipeline">Derived type. ex.: struct MyPipeline : public ParallelPipelineT<MyPipeline> {};</typeparam>
+    template<typename TDerivedPipeline, typename TChunkStructure, typename TSize>
+    struct ParallelPipelineT : public PipelineT<TDerivedPipeline, TChunkStructure, TSize>
+    {
+    public:
+        using Base_t = PipelineT<TDerivedPipeline, TChunkStructure, TSize>;
+        using Self_t = ParallelPipelineT<TDerivedPipeline, TChunkStructure, TSize>;
+        using Pipeline_t = TDerivedPipeline;
+        using ChunkStructure_t = TChunkStructure;
+        using Size_t = TSize;
+        using ComponentAccess_t = ComponentAccessT<Size_t>;
+
+    protected:
+        /// <summary>
+        /// Components read and written by each algorithm, in the order the Requirements visit them.
+        /// </summary>
+        std_vector<ComponentAccess_t> AlgorithmAccesses;
+
+        /// <summary>
+        /// Indices of the algorithms each algorithm depends on.
+        /// </summary>
+        std_vector<std_vector<Size_t>> AlgorithmDependencies;
+
+        /// <summary>
+        /// Indices of the algorithms of each level. Algorithms of a level only depend on algorithms of previous levels.
+        /// </summary>
+        std_vector<std_vector<Size_t>> Levels;
+
+        bool GraphBuilt = false;
+
+    public:
+        /// <summary>
+        /// Build the dependency graph between the pipeline's algorithms. Called on first run.
+        /// </summary>
+        void BuildGraph()
+        {
+            AlgorithmAccesses.clear();
+            Impl()->Requirements(PipelineRequirementCollectAccess<Size_t>(&AlgorithmAccesses));
+            const Size_t algorithmCount = (Size_t)AlgorithmAccesses.size();
+
+            AlgorithmDependencies.assign(algorithmCount, std_vector<Size_t>());
+            std_vector<Size_t> algorithmLevel(algorithmCount, 0);
+            Levels.clear();
+            for (Size_t i = 0; i < algorithmCount; ++i)
+            {
+                for (Size_t j = 0; j < i; ++j)
+                {
+                    if (AlgorithmAccesses[i].ConflictsWith(AlgorithmAccesses[j]))
+                    {
+                        AlgorithmDependencies[i].push_back(j);
+                        algorithmLevel[i] = std::max(algorithmLevel[i], algorithmLevel[j] + 1);
+                    }
+                }
+                if (algorithmLevel[i] >= (Size_t)Levels.size())
+                    Levels.resize(algorithmLevel[i] + 1);
+                Levels[algorithmLevel[i]].push_back(i);
+            }
+            GraphBuilt = true;
+        }
+
+        Size_t GetAlgorithmCount()const { return (Size_t)AlgorithmAccesses.size(); }
+        const ComponentAccess_t& GetAlgorithmAccess(const Size_t algorithmIndex)const { return AlgorithmAccesses[algorithmIndex]; }
+        const std_vector<Size_t>& GetAlgorithmDependencies(const Size_t algorithmIndex)const { return AlgorithmDependencies[algorithmIndex]; }
+        const std_vector<std_vector<Size_t>>& GetLevels()const { return Levels; }
+
+        /// <summary>
+        /// Run each of the pipeline's algorithms on a container, running algorithms of the same level concurrently.
+        /// Returns false without running any algorithm if the container does not match the pipeline,
+        /// or after running all of them if any algorithm failed its own requirements on the container.
+        /// </summary>
+        template<typename TContainer>
+        bool TryRunParallel(TContainer& container, const ParallelPolicy& policy = ParallelPolicy())
+        {
+            ni_assert(!container.IsNull());
+            if (!this->Match(&container.GetStructure()))
+                return false;
+            if (!GraphBuilt)
+                BuildGraph();
+            std::atomic<bool> allRan(true);
+            for (const std_vector<Size_t>& level : Levels)
+            {
+                if (level.size() == 1)
+                {
+                    if (!RunAlgorithm(level[0], container))
+                        allRan.store(false, std::memory_order_relaxed);
+                    continue;
+                }
+                ParallelPolicy levelPolicy(policy.ThreadCount, 1);
+                ParallelFor(levelPolicy, (Size_t)level.size(), [this, &level, &container, &allRan](const Size_t first, const Size_t count)
+                {
+                    for (Size_t i = first; i < first + count; ++i)
+                        if (!RunAlgorithm(level[i], container))
+                            allRan.store(false, std::memory_order_relaxed);
+                });
+            }
+            return allRan.load(std::memory_order_relaxed);
+        }
+
+        template<typename TContainer>
+        void RunParallel(TContainer& container, const ParallelPolicy& policy = ParallelPolicy())
+        {
+            if (!TryRunParallel(container, policy))
+            {
+                ni_assertf(false, TEXT("Could not run pipeline '%hs' on container '%hs'. The chunk failed the pipeline requirements."), typeid(Pipeline_t).name(), typeid(TContainer).name());
+            }
+        }
+
+    protected:
+        /// <summary>
+        /// Run the algorithm at an index on a container. Returns false if it failed its requirements on the container.
+        /// </summary>
+        template<typename TContainer>
+        bool RunAlgorithm(const Size_t algorithmIndex, TContainer& container)
+        {
+            bool ran = false;
+            Impl()->Requirements(PipelineRequirementRunAlgorithm<TContainer, Size_t>(algorithmIndex, &container, &ran));
+            return ran;
+        }
+
+    private:
+        Pipeline_t* Impl() { return (reinterpret_cast<Pipeline_t*>(this)); }
+    };
+
+    /// <summary>
+    /// Collect the component access of each algorithm of a pipeline.
+    /// </summary>
+    template<typename TSize>
+    struct PipelineRequirementCollectAccess
+    {
+    public:
+        using Size_t = TSize;
+        using ComponentAccess_t = ComponentAccessT<Size_t>;
+
+    protected:
+        std_vector<ComponentAccess_t>* const Accesses;
+
+    public:
+        PipelineRequirementCollectAccess(std_vector<ComponentAccess_t>* const accesses)
+            :Accesses(accesses)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            Accesses->push_back(ComponentAccess_t());
+            Routing::AlgorithmCollectAccess<Size_t>::Collect(algorithm, &Accesses->back());
+            return true;
+        }
+    };
+
+    /// <summary>
+    /// Run only the algorithm at an index of a pipeline on a container.
+    /// </summary>
+    template<typename TContainer, typename TSize>
+    struct PipelineRequirementRunAlgorithm
+    {
+    public:
+        using Size_t = TSize;
+
+    protected:
+        Size_t AlgorithmIndex;
+        Size_t CurrentAlgorithm;
+        TContainer* Container;
+        bool* Ran;
+
+    public:
+        PipelineRequirementRunAlgorithm(const Size_t algorithmIndex, TContainer* const container, bool* const ran)
+            : AlgorithmIndex(algorithmIndex)
+            , CurrentAlgorithm(0)
+            , Container(container)
+            , Ran(ran)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            if (CurrentAlgorithm++ == AlgorithmIndex)
+                *Ran = algorithm.TryRun(*Container);
+            return true;
+        }
+    };
+}
@@ -5,11 +5,33 @@
 #include "common.h"
 #include "routing\AlgorithmCacheRouter.h"
 #include "routing\AlgorithmMatchStructure.h"
+#include "routing\AlgorithmCollectMask.h"
+#include "routing\OffsetAlgorithmNodeSlice.h"
+
+// Bytes of node component data in each tile when running a pipeline's algorithms back-to-back with TryRunFused without a set tile size.
+#ifndef NI_PIPELINE_TILE_BYTES
+#   define NI_PIPELINE_TILE_BYTES 262144
+#endif
 
 namespace NiT
 {
+    template<typename TChunkStructure>
+    struct PipelineRequirementMatchForStructure;
+
+    template<typename TSize>
+    struct PipelineRequirementCollectMask;
+
+    template<typename TContainer>
+    struct PipelineRequirementRouteStage;
+
+    template<typename TContainer, typename TSize>
+    struct PipelineRequirementExecuteTile;
+
     /// <summary>
-    /// Extend this template struct to write your own pipeline to process Chunks
+    /// Extend this template struct to write your own pipeline to process Chunks.
+    /// A derived pipeline whose requirements only combine components with && can declare
+    /// static constexpr bool ConjunctiveRequirements = true; to let Match reject structures missing
+    /// a required component with the mask from GetRequiredMask before evaluating its requirements.
     /// </summary>
     /// <typeparam name="TDerivedPipeline">Derived type. ex.: struct MyPipeline : public PipelineT<MyPipeline> {};</typeparam>
     /// <typeparam name="TChunkStructure"></typeparam>
@@ -22,17 +44,56 @@ namespace NiT
         using Pipeline_t = TDerivedPipeline;
         using ChunkStructure_t = TChunkStructure;
         using Size_t = TSize;
+        using ComponentMask_t = ComponentMaskT<Size_t>;
 
     protected:
+        /// <summary>
+        /// True when the derived pipeline declares its requirements purely conjunctive with ConjunctiveRequirements.
+        /// </summary>
+        static constexpr bool IsConjunctive()
+        {
+            if constexpr (requires { Pipeline_t::ConjunctiveRequirements; })
+                return Pipeline_t::ConjunctiveRequirements;
+            else
+                return false;
+        }
+
         using CacheMap_t = std::unordered_map<const ChunkStructure_t*, bool>;
         mutable CacheMap_t ChunkStructureMatching;
 
+        /// <summary>
+        /// Component types required by all algorithms of the pipeline. Collected on first match.
+        /// </summary>
+        mutable ComponentMask_t RequiredMask;
+        mutable bool RequiredMaskCollected = false;
+
     public:
 
+        /// <summary>
+        /// Get the component types requested by all algorithms of the pipeline.
+        /// Only when the requirements are purely conjunctive is a chunk structure missing any of them sure to never match,
+        /// requirements using || or ! may match structures missing some of them.
+        /// </summary>
+        const ComponentMask_t& GetRequiredMask()
+        {
+            if (!RequiredMaskCollected)
+            {
+                Impl()->Requirements(PipelineRequirementCollectMask<Size_t>(&RequiredMask));
+                RequiredMaskCollected = true;
+            }
+            return RequiredMask;
+        }
+
         template<typename TChunkStructure>
         bool Match(const TChunkStructure* chunkStructure)
         {
             assert(chunkStructure != null);
+            // Reject structures missing a required component with a few mask operations, without caching them.
+            if constexpr (IsConjunctive())
+            {
+                if (!chunkStructure->HasAllComponents(GetRequiredMask()))
+                    return false;
+            }
             auto iMatching = ChunkStructureMatching.find(chunkStructure);
             if (iMatching == ChunkStructureMatching.end())
             {
@@ -67,6 +128,51 @@ namespace NiT
         template<typename TContainer>
         void Run(TContainer* container) = delete;
 
+        /// <summary>
+        /// Run all the pipeline's algorithms back-to-back on one tile of the container's nodes before moving to the next tile,
+        /// instead of running each algorithm on all nodes one after the other, so each tile's component data stays in cache.
+        /// Each stage of the pipeline must be an algorithm router such as AlgorithmCacheRouterT: the stage's algorithm is routed
+        /// with the router's cached routes for each tile, offset to the tile's first node and executed on the tile's nodes.
+        /// Each algorithm must only access the nodes it is executed on, and ChunkComponents are shared by all tiles.
+        /// Changed filters are not evaluated and the columns the algorithms write are not stamped in the chunk's CoChangeVersion:
+        /// algorithms always execute and algorithms filtering on those columns later do not see the writes.
+        /// Returns false without running any algorithm if the container has more than one chunk, does not match the pipeline
+        /// or fails to route a stage.
+        /// </summary>
+        /// <param name="container">Single chunk container to run the pipeline on.</param>
+        /// <param name="tileNodeCount">Nodes per tile. 0 fits NI_PIPELINE_TILE_BYTES of node component data per tile.</param>
+        template<typename TContainer>
+        bool TryRunFused(TContainer& container, Size_t tileNodeCount = 0)
+        {
+            assert(!container.IsNull());
+            // Tiles are slices of the nodes of a single chunk.
+            if constexpr (requires { container.GetChunkCount(); })
+            {
+                if (container.GetChunkCount() != 1)
+                    return false;
+            }
+            if (!Match(&container.GetStructure()))
+                return false;
+            // Route every stage once before executing any so a stage failing its requirements leaves the container untouched.
+            if (!Impl()->Requirements(PipelineRequirementRouteStage<TContainer>(&container)))
+                return false;
+            if (tileNodeCount <= 0)
+                tileNodeCount = std::max<Size_t>(1, (Size_t)(NI_PIPELINE_TILE_BYTES / std::max<Size_t>(1, container.GetStructure().BlockNodeSize)));
+            const Size_t nodeCount = container.GetNodeCount();
+            for (Size_t firstNode = 0; firstNode < nodeCount; firstNode += tileNodeCount)
+                Impl()->Requirements(PipelineRequirementExecuteTile<TContainer, Size_t>(&container, firstNode, std::min(tileNodeCount, nodeCount - firstNode)));
+            return true;
+        }
+
+        template<typename TContainer>
+        void RunFused(TContainer& container, Size_t tileNodeCount = 0)
+        {
+            if (!TryRunFused(container, tileNodeCount))
+            {
+                ni_assertf(false, TEXT("Could not run pipeline '%hs' on container '%hs'. The chunk failed the pipeline requirements."), typeid(Pipeline_t).name(), typeid(TContainer).name());
+            }
+        }
+
     private:
         Pipeline_t* Impl() { return (reinterpret_cast<Pipeline_t*>(this)); }
     };
@@ -92,4 +198,85 @@ namespace NiT
             return algorithm.Requirements(Routing::AlgorithmMatchStructure<TChunkStructure>(ChunkStructure));
         }
     };
-}
\ No newline at end of file
+
+    template<typename TSize>
+    struct PipelineRequirementCollectMask
+    {
+    public:
+        using Size_t = TSize;
+        using ComponentMask_t = ComponentMaskT<Size_t>;
+
+    protected:
+        ComponentMask_t* const Mask;
+
+    public:
+        PipelineRequirementCollectMask(ComponentMask_t* const mask)
+            :Mask(mask)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            return algorithm.Requirements(Routing::AlgorithmCollectMask<Size_t>(Mask));
+        }
+    };
+
+    /// <summary>
+    /// Route the algorithm of each stage of a pipeline to a container, caching the routes in the stage's router.
+    /// </summary>
+    template<typename TContainer>
+    struct PipelineRequirementRouteStage
+    {
+    protected:
+        TContainer* Container;
+
+    public:
+        PipelineRequirementRouteStage(TContainer* const container)
+            :Container(container)
+        {
+        }
+
+        template<typename TRouter>
+        bool Algorithm(TRouter& router)
+        {
+            static_assert(requires { typename TRouter::Algorithm_t; }, "Pipeline stages must be algorithm routers to run fused, ex.: AlgorithmCacheRouterT.");
+            typename TRouter::Algorithm_t algorithm;
+            return router.RouteAlgorithm(algorithm, *Container);
+        }
+    };
+
+    /// <summary>
+    /// Execute the algorithm of each stage of a pipeline on a tile of nodes of a container.
+    /// </summary>
+    template<typename TContainer, typename TSize>
+    struct PipelineRequirementExecuteTile
+    {
+    public:
+        using Size_t = TSize;
+
+    protected:
+        TContainer* Container;
+        Size_t FirstNode;
+        Size_t TileNodeCount;
+
+    public:
+        PipelineRequirementExecuteTile(TContainer* const container, const Size_t firstNode, const Size_t tileNodeCount)
+            : Container(container)
+            , FirstNode(firstNode)
+            , TileNodeCount(tileNodeCount)
+        {
+        }
+
+        template<typename TRouter>
+        bool Algorithm(TRouter& router)
+        {
+            typename TRouter::Algorithm_t algorithm;
+            if (!router.RouteAlgorithm(algorithm, *Container))
+                return false;
+            algorithm.Requirements(Routing::OffsetAlgorithmNodeSlice<TContainer>(FirstNode));
+            algorithm.Execute(PropNodeCountT<Size_t>(TileNodeCount));
+            return true;
+        }
+    };
+}
@@ -340,6 +340,7 @@ namespace NiT
         }
     };
 
+    template<typename TCS  > struct PropTraits<const TCS*>                   : public PropTraitsDefault2<TCS, const TCS*, DStructurePtr> {};
     template<              > struct PropTraits<void**>                       : public PropTraitsDefault<DComponentDataArray> {};
     template<              > struct PropTraits<PropComponentDataArray>       : public PropTraitsDefault<DComponentDataArray> {};
     template<typename TSize> struct PropTraits<NodeCountT<           TSize>> : public PropTraitsDefault<DNodeCount> {};
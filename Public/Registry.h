@@ -19,7 +19,10 @@ namespace NiT
 
     public:
         std_vector<Unique_Ptr<ComponentType_t>> ComponentTypes;
-        std_unordered_map<const type_info*, Size_t> TypeToComponentTypeIndex;
+        /// <summary>
+        /// Component type of each dense component type id, see ComponentTypeIdT. Null for ids not added to this registry.
+        /// </summary>
+        std_vector<const ComponentType_t*> IdToComponentType;
 
     public:
         template<typename T>
@@ -29,25 +32,32 @@ namespace NiT
             auto componentType = std_make_unique<ComponentType_t>((T*)nullptr, T::Owner);
             auto* ptr = componentType.get();
             ComponentTypes.push_back(std::move(componentType));
-            TypeToComponentTypeIndex.insert({ &typeid(T), ComponentTypes.size() - 1 });
+            const Size_t id = ptr->GetId();
+            if (id >= (Size_t)IdToComponentType.size())
+                IdToComponentType.resize(id + 1, nullptr);
+            IdToComponentType[id] = ptr;
             return ptr;
         }
         template<typename T>
         const ComponentType_t* GetOrAddComponentType()
         {
-            auto i = TypeToComponentTypeIndex.find(&typeid(T));
-            if (i != TypeToComponentTypeIndex.end())
-                return ComponentTypes[i->second].get();
+            const ComponentType_t* const componentType = GetComponentType<T>();
+            if (componentType)
+                return componentType;
             return AddComponentType<T>();
         }
 
         template<typename T>
         const ComponentType_t* GetComponentType()
         {
-            auto i = TypeToComponentTypeIndex.find(&typeid(T));
-            if (i != TypeToComponentTypeIndex.end())
-                return ComponentTypes[i->second].get();
-            return nullptr;
+            return GetComponentTypeById(ComponentTypeIdT<Size_t>::template Get<T>());
+        }
+
+        const ComponentType_t* GetComponentTypeById(const Size_t id)const
+        {
+            if (id >= (Size_t)IdToComponentType.size())
+                return nullptr;
+            return IdToComponentType[id];
         }
     };
 
@@ -62,34 +72,47 @@ namespace NiT
         using ChunkStructureHasher_t = typename ChunkStructure_t::Hasher_t;
         using ChunkStructureEqualler_t = typename ChunkStructure_t::Equaler_t;
         using ComponentTypeRegistry_t = ComponentTypeRegistryT<ComponentType_t>;
+        using ComponentMask_t = typename ChunkStructure_t::ComponentMask_t;
         using Size_t = typename ChunkStructure_t::Size_t;
     public:
         // Keep an array of all our chunk structures
         std_vector<Unique_Ptr<ChunkStructure_t>> ChunkStructures;
         std_unordered_map< const ChunkStructure_t*, std::size_t, ChunkStructureHasher_t, ChunkStructureEqualler_t> ChunkStructureToIndex;
 
+    protected:
+        /// <summary>
+        /// Guards interning and the add/remove component edges of all chunk structures of this registry,
+        /// so structural changes can resolve neighbouring structures from multiple threads.
+        /// </summary>
+        std::mutex Mutex;
+
+    public:
+        ChunkStructureRegistryT() = default;
+
+        ChunkStructureRegistryT(ChunkStructureRegistryT&& other)
+            : ChunkStructures(std::move(other.ChunkStructures))
+            , ChunkStructureToIndex(std::move(other.ChunkStructureToIndex))
+        {
+        }
+        ChunkStructureRegistryT& operator=(ChunkStructureRegistryT&& other)
+        {
+            ChunkStructures = std::move(other.ChunkStructures);
+            ChunkStructureToIndex = std::move(other.ChunkStructureToIndex);
+            return *this;
+        }
+
         const ChunkStructure_t* GetOrAddChunkStructure(const ComponentType_t* component)
         {
             auto chunkStructure = std_make_unique<ChunkStructure_t>(component);
-            auto ptr = chunkStructure.get();
-            auto i = ChunkStructureToIndex.find(ptr);
-            if (i != ChunkStructureToIndex.end())
-                return i->first;
-            ChunkStructures.push_back(std::move(chunkStructure));
-            ChunkStructureToIndex.insert(i, { ptr, ChunkStructures.size() - 1 });
-            return ptr;
+            std::lock_guard<std::mutex> lock(Mutex);
+            return GetOrAddChunkStructureUnsafe(std::move(chunkStructure));
         }
         // Add a chunk structure from a list of component type
         const ChunkStructure_t* GetOrAddChunkStructure(const std::initializer_list<const ComponentType_t*>& aComponents)
         {
             auto chunkStructure = std_make_unique<ChunkStructure_t>(aComponents);
-            auto ptr = chunkStructure.get();
-            auto i = ChunkStructureToIndex.find(ptr);
-            if (i != ChunkStructureToIndex.end())
-                return i->first;
-            ChunkStructures.push_back(std::move(chunkStructure));
-            ChunkStructureToIndex.insert(i, { ptr, ChunkStructures.size() - 1 });
-            return ptr;
+            std::lock_guard<std::mutex> lock(Mutex);
+            return GetOrAddChunkStructureUnsafe(std::move(chunkStructure));
         }
 
 
@@ -99,8 +122,114 @@ namespace NiT
             std_vector<const ComponentType_t*> componentTypes(sizeof...(TComponentTypes));
             Size_t c = 0;
             ((componentTypes[c++] = componentTypeRegistry.GetOrAddComponentType<TComponentTypes>()), ...);
+            return GetOrAddChunkStructure(std::move(componentTypes));
+        }
 
+
+        /// <summary>
+        /// Get or add the chunk structure with all component types of a structure plus one.
+        /// Resolved once per structure and component type, then a cached edge lookup that does not allocate.
+        /// </summary>
+        const ChunkStructure_t* GetOrAddChunkStructureWith(const ChunkStructure_t* const chunkStructure, const ComponentType_t* const component)
+        {
+            ni_assert(chunkStructure != nullptr);
+            ni_assert(component != nullptr);
+            const Size_t id = component->GetId();
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (const ChunkStructure_t* const cached = chunkStructure->GetAddComponentEdge(id))
+                return cached;
+            const ChunkStructure_t* result = chunkStructure;
+            if (chunkStructure->GetComponentTypeIndexInChunkById(id) == -1)
+            {
+                std_vector<const ComponentType_t*> componentTypes;
+                componentTypes.reserve(chunkStructure->GetComponentCount() + 1);
+                for (Size_t i = 0; i < chunkStructure->GetComponentCount(); ++i)
+                    componentTypes.push_back(&chunkStructure->GetComponentType(i));
+                componentTypes.push_back(component);
+                result = GetOrAddChunkStructureUnsafe(std_make_unique<ChunkStructure_t>(std::move(componentTypes)));
+                result->SetRemoveComponentEdge(id, chunkStructure);
+            }
+            chunkStructure->SetAddComponentEdge(id, result);
+            return result;
+        }
+
+        /// <summary>
+        /// Get or add the chunk structure with all component types of a structure but one.
+        /// Resolved once per structure and component type, then a cached edge lookup that does not allocate.
+        /// </summary>
+        const ChunkStructure_t* GetOrAddChunkStructureWithout(const ChunkStructure_t* const chunkStructure, const ComponentType_t* const component)
+        {
+            ni_assert(chunkStructure != nullptr);
+            ni_assert(component != nullptr);
+            const Size_t id = component->GetId();
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (const ChunkStructure_t* const cached = chunkStructure->GetRemoveComponentEdge(id))
+                return cached;
+            const ChunkStructure_t* result = chunkStructure;
+            const Size_t removedIndex = chunkStructure->GetComponentTypeIndexInChunkById(id);
+            if (removedIndex != -1)
+            {
+                std_vector<const ComponentType_t*> componentTypes;
+                componentTypes.reserve(chunkStructure->GetComponentCount());
+                for (Size_t i = 0; i < chunkStructure->GetComponentCount(); ++i)
+                    if (i != removedIndex)
+                        componentTypes.push_back(&chunkStructure->GetComponentType(i));
+                result = GetOrAddChunkStructureUnsafe(std_make_unique<ChunkStructure_t>(std::move(componentTypes)));
+                result->SetAddComponentEdge(id, chunkStructure);
+            }
+            chunkStructure->SetRemoveComponentEdge(id, result);
+            return result;
+        }
+
+        // Add a chunk structure from a vector of component types
+        const ChunkStructure_t* GetOrAddChunkStructure(std_vector<const ComponentType_t*>&& componentTypes)
+        {
             auto chunkStructure = std_make_unique<ChunkStructure_t>(std::move(componentTypes));
+            std::lock_guard<std::mutex> lock(Mutex);
+            return GetOrAddChunkStructureUnsafe(std::move(chunkStructure));
+        }
+
+        /// <summary>
+        /// Call function(chunkStructure) for each chunk structure having all component types of a mask.
+        /// </summary>
+        template<typename TFunction>
+        void ForEachChunkStructureWith(const ComponentMask_t& required, TFunction function)const
+        {
+            for (const Unique_Ptr<ChunkStructure_t>& chunkStructure : ChunkStructures)
+                if (chunkStructure->HasAllComponents(required))
+                    function(chunkStructure.get());
+        }
+
+        /// <summary>
+        /// Call function(chunkStructure) for each chunk structure having all component types of a mask
+        /// and none of the component types of another.
+        /// </summary>
+        template<typename TFunction>
+        void ForEachChunkStructureWith(const ComponentMask_t& required, const ComponentMask_t& excluded, TFunction function)const
+        {
+            for (const Unique_Ptr<ChunkStructure_t>& chunkStructure : ChunkStructures)
+                if (chunkStructure->HasAllComponents(required) && !chunkStructure->HasAnyComponents(excluded))
+                    function(chunkStructure.get());
+        }
+
+        /// <summary>
+        /// Get all chunk structures having all component types of TComponentTypes.
+        /// </summary>
+        template<typename... TComponentTypes>
+        void GetChunkStructuresWith(std_vector<const ChunkStructure_t*>* const result)const
+        {
+            ComponentMask_t required;
+            (required.template Set<TComponentTypes>(), ...);
+            ForEachChunkStructureWith(required, [result](const ChunkStructure_t* chunkStructure) { result->push_back(chunkStructure); });
+        }
+
+    protected:
+        /// <summary>
+        /// Get the interned chunk structure equal to chunkStructure, or intern it.
+        /// Must be called under Mutex.
+        /// </summary>
+        const ChunkStructure_t* GetOrAddChunkStructureUnsafe(Unique_Ptr<ChunkStructure_t>&& chunkStructure)
+        {
             auto ptr = chunkStructure.get();
             auto i = ChunkStructureToIndex.find(ptr);
             if (i != ChunkStructureToIndex.end())
@@ -109,7 +238,6 @@ namespace NiT
             ChunkStructureToIndex.insert(i, { ptr, ChunkStructures.size() - 1 });
             return ptr;
         }
-
     };
 
     template<typename TChunk, typename TChunkArray>
@@ -260,6 +388,20 @@ namespace NiT
             return ChunkStructureRegistry.GetOrAddChunkStructure<TComponentTypes...>(ComponentTypeRegistry);
         }
 
+        // Get the chunk structure with one more component type than another
+        template<typename T>
+        const ChunkStructure_t* GetOrAddChunkStructureWith(const ChunkStructure_t* const chunkStructure)
+        {
+            return ChunkStructureRegistry.GetOrAddChunkStructureWith(chunkStructure, GetOrAddComponentType<T>());
+        }
+
+        // Get the chunk structure with one less component type than another
+        template<typename T>
+        const ChunkStructure_t* GetOrAddChunkStructureWithout(const ChunkStructure_t* const chunkStructure)
+        {
+            return ChunkStructureRegistry.GetOrAddChunkStructureWithout(chunkStructure, GetOrAddComponentType<T>());
+        }
+
         Chunk_t* NewChunk(const ChunkStructure_t* const chunkStructure, const NodeCountT<Size_t> nodeCount)
         {
             return ChunkRegistry.NewChunk(chunkStructure, nodeCount);
@@ -306,3 +448,6 @@ namespace Ni
     using ChunkTreeRegistry = NiT::ChunkRegistryT<KChunkTree, KArrayTree>;
     using PncRegistry = NiT::PncRegistryT<ChunkStructure>;
 }
+
+// Depends on the Ni registry aliases above.
+#include "CommandBuffer.h"
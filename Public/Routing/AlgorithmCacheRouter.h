@@ -5,10 +5,15 @@
 #include "common.h"
 #include "SetAlgorithmChunk.h"
 #include "AlgorithmRequirementFulfiller.h"
+#include "AlgorithmCollectMask.h"
 
 namespace NiT::Routing
 {
 
+    /// <summary>
+    /// Component type index in chunk of each component an algorithm requires, in the order the algorithm requests them.
+    /// Routes are stored inline so a router's routes for all structures are a single flat array.
+    /// </summary>
     template<typename TSize>
     struct RouteT
     {
@@ -16,25 +21,47 @@ namespace NiT::Routing
         using Self_t = RouteT<TSize>;
         using Size_t = TSize;
 
+        static constexpr Size_t Capacity = NI_ROUTE_CAPACITY;
+
+        enum class RouteState : uint8
+        {
+            Unrouted,
+            Match,
+            Mismatch,
+        };
+
     public:
-        std_vector<Size_t> Components;
+        Size_t Components[Capacity];
+        Size_t ComponentCount = 0;
+        RouteState State = RouteState::Unrouted;
 
         Size_t operator[](Size_t routeIndex)const
         {
+            ni_assert_slow(routeIndex < ComponentCount);
             return Components[routeIndex];
         }
 
         void AddRoute(Size_t componentTypeIndexInChunk)
         {
-            Components.push_back(componentTypeIndexInChunk);
+            ni_assertf(ComponentCount < Capacity, TEXT("An algorithm requires more than NI_ROUTE_CAPACITY (%d) components."), (int)Capacity);
+            Components[ComponentCount++] = componentTypeIndexInChunk;
+        }
+        void MarkMatch()
+        {
+            State = RouteState::Match;
         }
         void MarkMismatch()
         {
-            Components.clear();
+            ComponentCount = 0;
+            State = RouteState::Mismatch;
+        }
+        bool IsRouted()const
+        {
+            return State != RouteState::Unrouted;
         }
         bool IsMismatch()const
         {
-            return Components.size() == 0;
+            return State == RouteState::Mismatch;
         }
     };
 
@@ -65,7 +92,7 @@ namespace NiT::Routing
         bool Component(T*& component)
         {
             const auto& chunkStructure = this->Container->GetStructure();
-            auto componentTypeIndexInChunk = chunkStructure.GetComponentTypeIndexInChunk(&typeid(T));
+            auto componentTypeIndexInChunk = chunkStructure.template GetComponentTypeIndexInChunk<T>();
             Route->AddRoute(componentTypeIndexInChunk);
 
             if (componentTypeIndexInChunk == -1)
@@ -88,7 +115,7 @@ namespace NiT::Routing
         using Self_t = RouteAlgorithmWithCacheT<TContainer, TSize>;
         using Container_t = TContainer;
         using Size_t = TSize;
-        using AlgorithmRoute_t = typename RouteT<TSize>;
+        using AlgorithmRoute_t = RouteT<TSize>;
 
     protected:
         AlgorithmRoute_t* Route;
@@ -108,7 +135,7 @@ namespace NiT::Routing
             auto componentTypeIndexInChunk = (*Route)[CurrentComponentRoute];
             ++CurrentComponentRoute;
             // Make sure the cache is valid
-            //assert(componentTypeIndexInChunk == Chunk->GetStructure().GetComponentTypeIndexInChunk(&typeid(T)));
+            //assert(componentTypeIndexInChunk == Chunk->GetStructure().template GetComponentTypeIndexInChunk<T>());
 
             if (componentTypeIndexInChunk == (Size_t)-1)
                 return false;
@@ -137,9 +164,28 @@ namespace NiT::Routing
 
     protected:
         using AlgorithmRoute_t = RouteT<TSize>;
-        using Map_t = std_unordered_map<const ChunkStructure_t*, AlgorithmRoute_t*>;
-        mutable Map_t Cache;
-        mutable std_list<AlgorithmRoute_t> CachedRoutes;
+        /// <summary>
+        /// Route of each chunk structure this router was used with, in the order they were first routed.
+        /// </summary>
+        mutable std_vector<AlgorithmRoute_t> Routes;
+
+        /// <summary>
+        /// Index in Routes of each chunk structure's route, indexed by ChunkStructureT::GetIndex(). -1 when not routed yet.
+        /// Keeps the table indexed by all structures small while Routes only grows with the structures this router sees.
+        /// </summary>
+        mutable std_vector<Size_t> RouteSlots;
+
+        using ComponentMask_t = ComponentMaskT<Size_t>;
+        /// <summary>
+        /// Component types required by the algorithm. Collected on first route.
+        /// </summary>
+        mutable ComponentMask_t RequiredMask;
+        mutable bool RequiredMaskCollected = false;
+
+        /// <summary>
+        /// Algorithm run by TryRun and Run without an algorithm, kept so its Changed filters' lastRunVersion persists between runs.
+        /// </summary>
+        mutable Algorithm_t Algorithm;
 
     public:
         AlgorithmCacheRouterT() {}
@@ -170,12 +216,30 @@ namespace NiT::Routing
             //TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("Routing"));
             const ChunkStructure_t* chunkStructure = &container.GetStructure();
 
-            typename Map_t::iterator i = Cache.find(chunkStructure);
-            if (i == Cache.end())
+            const Size_t structureIndex = chunkStructure->GetIndex();
+            if (structureIndex >= (Size_t)RouteSlots.size())
+                RouteSlots.resize(std::max<std::size_t>(structureIndex + 1, RouteSlots.size() * 2), (Size_t)-1);
+            Size_t& routeSlot = RouteSlots[structureIndex];
+            if (routeSlot == (Size_t)-1)
+            {
+                routeSlot = (Size_t)Routes.size();
+                Routes.emplace_back();
+            }
+            AlgorithmRoute_t* route = &Routes[routeSlot];
+            if (!route->IsRouted())
             {
-                CachedRoutes.push_back(AlgorithmRoute_t());
-                AlgorithmRoute_t* route = &CachedRoutes.back();
-                Cache[chunkStructure] = route;
+                if (!RequiredMaskCollected)
+                {
+                    AlgorithmCollectMask<Size_t> collectMask(&RequiredMask);
+                    algorithm.template Requirements<AlgorithmCollectMask<Size_t>&>(collectMask);
+                    RequiredMaskCollected = true;
+                }
+                // Structures missing a required component are known mismatches without routing each requirement.
+                if (!chunkStructure->HasAllComponents(RequiredMask))
+                {
+                    route->MarkMismatch();
+                    return false;
+                }
                 AlgorithmRouteToCache_t routeToCache(&container, route);
                 bool matches = algorithm.template Requirements<AlgorithmRouteToCache_t&>(routeToCache);
                 if (!routeToCache.MatchForChunk)
@@ -183,15 +247,13 @@ namespace NiT::Routing
                     route->MarkMismatch();
                     return false;
                 }
+                route->MarkMatch();
                 return matches;
             }
-            else
-            {
-                if (i->second->IsMismatch())
-                    return false;
-                AlgorithmRouteWithCache_t router(&container, i->second);
-                return algorithm.template Requirements<AlgorithmRouteWithCache_t&>(router);
-            }
+            if (route->IsMismatch())
+                return false;
+            AlgorithmRouteWithCache_t router(&container, route);
+            return algorithm.template Requirements<AlgorithmRouteWithCache_t&>(router);
         }
 
         template<typename TContainer>
@@ -203,9 +265,28 @@ namespace NiT::Routing
         template<typename TContainer>
         bool TryRun(TContainer& container) const
         {
-            return Algorithm_t().TryRun(*this, container);
+            return Algorithm.TryRun(*this, container);
+        }
+
+        /// <summary>
+        /// Run the router's algorithm on a container as part of a run over multiple containers, see Algorithm::BeginRun.
+        /// </summary>
+        template<typename TContainer>
+        bool TryRun(TContainer& container, const uint32 runVersion) const
+        {
+            return Algorithm.TryRun(*this, container, runVersion);
         }
 
+        /// <summary>
+        /// Commit a run of the router's algorithm once all containers ran with runVersion, see Algorithm::CommitRun.
+        /// </summary>
+        void CommitRun(const uint32 runVersion) const
+        {
+            Algorithm.CommitRun(runVersion);
+        }
+
+        Algorithm_t& GetAlgorithm() const { return Algorithm; }
+
         template<typename TContainer>
         void Run(const Algorithm_t& algorithm, TContainer& container) const
         {
@@ -215,7 +296,7 @@ namespace NiT::Routing
         template<typename TContainer>
         void Run(TContainer& container) const
         {
-            Algorithm_t().Run(*this, container);
+            Algorithm.Run(*this, container);
         }
     };
 
@@ -0,0 +1,190 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+#include "Components.h"
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Evaluate the Changed filters of an algorithm on a chunk without routing any component.
+    /// The chunk passes if the algorithm has no filters, if the chunk has no CoChangeVersion, or if
+    /// any filtered component was written since the algorithm's last run.
+    /// </summary>
+    /// <typeparam name="TChunk">Chunk or chunk element</typeparam>
+    template<typename TChunk>
+    struct FilterAlgorithmChange : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = FilterAlgorithmChange<TChunk>;
+        using Chunk_t = TChunk;
+        using Size_t = typename Chunk_t::Size_t;
+        using CoChangeVersion_t = CoChangeVersionT<Size_t>;
+
+    protected:
+        Chunk_t* Chunk;
+        const CoChangeVersion_t* Versions;
+        bool HasFilter;
+        bool IsAnyChanged;
+
+    public:
+        FilterAlgorithmChange(Chunk_t& chunk)
+            : Chunk(&chunk)
+            , Versions(nullptr)
+            , HasFilter(false)
+            , IsAnyChanged(false)
+        {
+            const auto index = chunk.GetStructure().template GetComponentTypeIndexInChunk<CoChangeVersion_t>();
+            if (index >= 0)
+                Versions = (const CoChangeVersion_t*)chunk.GetComponentData(index);
+        }
+
+        template<typename T>
+        bool Component(T*& component) { return true; }
+        template<typename T>
+        bool ParentComponent(T*& component) { return true; }
+        template<typename TChunkPointer>
+        bool ParentChunk(TChunkPointer*& parent) { return true; }
+        template<typename TChunkPointer>
+        bool ChildrenChunk(TChunkPointer*& children) { return true; }
+        bool ChunkIndex(Size_t& index) { return true; }
+
+        template<typename T>
+        bool Changed(T*& component, uint32& lastRunVersion)
+        {
+            HasFilter = true;
+            if (IsAnyChanged)
+                return true;
+            if (Versions == nullptr)
+            {
+                IsAnyChanged = true;
+                return true;
+            }
+            const auto index = Chunk->GetStructure().template GetComponentTypeIndexInChunk<T>();
+            IsAnyChanged = index < 0 || Versions->IsChanged(index, lastRunVersion);
+            return true;
+        }
+
+        bool ShouldExecute()const { return !HasFilter || IsAnyChanged; }
+
+        /// <summary>
+        /// Test if an algorithm should execute on a chunk according to its Changed filters.
+        /// </summary>
+        template<typename TAlgorithm>
+        static bool ShouldExecute(TAlgorithm& algorithm, Chunk_t& chunk)
+        {
+            Self_t filter(chunk);
+            algorithm.template Requirements<Self_t&>(filter);
+            return filter.ShouldExecute();
+        }
+    };
+
+    /// <summary>
+    /// Stamp the columns of a chunk an algorithm requires write access to (non-const component pointers) with the run's ChangeVersion.
+    /// Does nothing on chunks without CoChangeVersion.
+    /// </summary>
+    /// <typeparam name="TChunk">Chunk or chunk element</typeparam>
+    template<typename TChunk>
+    struct StampAlgorithmChange : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = StampAlgorithmChange<TChunk>;
+        using Chunk_t = TChunk;
+        using Size_t = typename Chunk_t::Size_t;
+        using CoChangeVersion_t = CoChangeVersionT<Size_t>;
+
+    protected:
+        Chunk_t* Chunk;
+        CoChangeVersion_t* Versions;
+        uint32 Version;
+
+    public:
+        StampAlgorithmChange(Chunk_t& chunk, const uint32 version)
+            : Chunk(&chunk)
+            , Versions(nullptr)
+            , Version(version)
+        {
+            const auto index = chunk.GetStructure().template GetComponentTypeIndexInChunk<CoChangeVersion_t>();
+            if (index >= 0)
+                Versions = (CoChangeVersion_t*)chunk.GetComponentData(index);
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            if constexpr (!std::is_const_v<T>)
+            {
+                const auto index = Chunk->GetStructure().template GetComponentTypeIndexInChunk<T>();
+                if (index >= 0)
+                    Versions->SetChanged(index, Version);
+            }
+            return true;
+        }
+        template<typename T>
+        bool ParentComponent(T*& component) { return true; }
+        template<typename TChunkPointer>
+        bool ParentChunk(TChunkPointer*& parent) { return true; }
+        template<typename TChunkPointer>
+        bool ChildrenChunk(TChunkPointer*& children) { return true; }
+        bool ChunkIndex(Size_t& index) { return true; }
+
+        /// <summary>
+        /// Stamp the columns of a chunk an algorithm writes to with version.
+        /// </summary>
+        template<typename TAlgorithm>
+        static void Stamp(TAlgorithm& algorithm, Chunk_t& chunk, const uint32 version)
+        {
+            Self_t stamp(chunk, version);
+            if (stamp.Versions == nullptr)
+                return;
+            algorithm.template Requirements<Self_t&>(stamp);
+        }
+    };
+
+    /// <summary>
+    /// Set the lastRunVersion of all Changed filters of an algorithm once a run is done.
+    /// </summary>
+    struct CommitAlgorithmChange : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = CommitAlgorithmChange;
+
+    protected:
+        uint32 Version;
+
+    public:
+        CommitAlgorithmChange(const uint32 version)
+            : Version(version)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component) { return true; }
+        template<typename T>
+        bool ParentComponent(T*& component) { return true; }
+        template<typename TChunkPointer>
+        bool ParentChunk(TChunkPointer*& parent) { return true; }
+        template<typename TChunkPointer>
+        bool ChildrenChunk(TChunkPointer*& children) { return true; }
+        template<typename TSize>
+        bool ChunkIndex(TSize& index) { return true; }
+
+        template<typename T>
+        bool Changed(T*& component, uint32& lastRunVersion)
+        {
+            lastRunVersion = Version;
+            return true;
+        }
+
+        template<typename TAlgorithm>
+        static void Commit(TAlgorithm& algorithm, const uint32 version)
+        {
+            algorithm.Requirements(Self_t(version));
+        }
+    };
+}
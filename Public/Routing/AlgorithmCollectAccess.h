@@ -0,0 +1,84 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+#include "AlgorithmRequirementPaths.h"
+#include "ComponentAccess.h"
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Collect the component types an algorithm reads and writes.
+    /// Component(const T*&) is a read and Component(T*&) a write.
+    /// Parent components are collected too since they are data the algorithm touches while running.
+    /// Use Collect to evaluate the Requirements on every path so the components of all operands of || and ?: are collected.
+    /// </summary>
+    template<typename TSize>
+    struct AlgorithmCollectAccess : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = AlgorithmCollectAccess<TSize>;
+        using Size_t = TSize;
+        using ComponentAccess_t = ComponentAccessT<Size_t>;
+
+    protected:
+        ComponentAccess_t* const Access;
+        AlgorithmRequirementPaths* const Paths;
+
+    public:
+        AlgorithmCollectAccess(ComponentAccess_t* const access, AlgorithmRequirementPaths* const paths)
+            :Access(access)
+            , Paths(paths)
+        {
+        }
+
+        /// <summary>
+        /// Collect the component types an algorithm reads and writes on any path through its Requirements.
+        /// </summary>
+        template<typename TAlgorithm>
+        static void Collect(TAlgorithm& algorithm, ComponentAccess_t* const access)
+        {
+            AlgorithmRequirementPaths paths;
+            do
+            {
+                Self_t collectAccess(access, &paths);
+                algorithm.template Requirements<Self_t&>(collectAccess);
+            } while (paths.NextPath());
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            Access->template Add<T>();
+            return Paths->Answer();
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            Access->template Add<T>();
+            return Paths->Answer();
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return Paths->Answer();
+        }
+
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return Paths->Answer();
+        }
+
+        template<typename TIndex>
+        bool ChunkIndex(TIndex& index)
+        {
+            return Paths->Answer();
+        }
+    };
+}
@@ -0,0 +1,68 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+#include "ComponentMask.h"
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Collect the ids of all component types an algorithm requires in a ComponentMask.
+    /// Every component requested through Component() is considered required, the same way
+    /// RouteAlgorithmToCacheT marks a chunk structure as mismatching when any of them is missing.
+    /// Every requirement returns true so only the first operand of || is visited: the mask is only
+    /// the exact set of required components for requirements combined with &&.
+    /// Parent and children requirements are not part of the chunk structure and are ignored.
+    /// </summary>
+    template<typename TSize>
+    struct AlgorithmCollectMask : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = AlgorithmCollectMask<TSize>;
+        using Size_t = TSize;
+        using ComponentMask_t = ComponentMaskT<Size_t>;
+
+    protected:
+        ComponentMask_t* const Mask;
+
+    public:
+        AlgorithmCollectMask(ComponentMask_t* const mask)
+            :Mask(mask)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            Mask->template Set<T>();
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return true;
+        }
+
+        template<typename TIndex>
+        bool ChunkIndex(TIndex& index)
+        {
+            return true;
+        }
+    };
+}
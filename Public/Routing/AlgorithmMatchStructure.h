@@ -27,7 +27,7 @@ namespace NiT::Routing
         template<typename T>
         bool Component(T*& component)
         {
-            auto index = ChunkStructure->GetComponentTypeIndexInChunk(&typeid(T));
+            auto index = ChunkStructure->template GetComponentTypeIndexInChunk<T>();
             return index >= 0;
         }
 
@@ -0,0 +1,49 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Answers to the requirements of an algorithm for each possible path through its Requirements.
+    /// A requirement fulfiller returning the same result for every requirement only visits one operand of each ||, && or ?:.
+    /// Fulfillers answering with Answer() instead, while Requirements is evaluated until NextPath() returns false,
+    /// visit every requirement reachable with any combination of requirement results.
+    /// Each requirement is answered true first, then the last one answered true is flipped to false on the next path.
+    /// Requirements combined with && only take one more path than their number of requirements.
+    /// </summary>
+    struct AlgorithmRequirementPaths
+    {
+    protected:
+        std_vector<bool> Answers;
+        std::size_t NextRequirement = 0;
+
+    public:
+        /// <summary>
+        /// Get the result of the next requirement on the current path.
+        /// </summary>
+        bool Answer()
+        {
+            if (NextRequirement == Answers.size())
+                Answers.push_back(true);
+            return Answers[NextRequirement++];
+        }
+
+        /// <summary>
+        /// Start the next path. Returns false once all paths were visited.
+        /// </summary>
+        bool NextPath()
+        {
+            Answers.resize(NextRequirement);
+            NextRequirement = 0;
+            while (!Answers.empty() && !Answers.back())
+                Answers.pop_back();
+            if (Answers.empty())
+                return false;
+            Answers.back() = false;
+            return true;
+        }
+    };
+}
@@ -36,7 +36,7 @@ namespace NiT::Routing
         template<typename TContainer>
         bool RouteAlgorithm(Algorithm_t& algorithm, TContainer& container) const
         {
-            return algorithm.Requirements(SetAlgorithmChunk<TContainer>());
+            return algorithm.Requirements(SetAlgorithmChunk<TContainer>(&container));
         }
 
         template<typename TContainer>
@@ -0,0 +1,62 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Offset the NodeComponent pointers of an algorithm to a slice of nodes in the same chunk.
+    /// ChunkComponent pointers are left untouched so all slices of a chunk share the same chunk data,
+    /// which must only be read by algorithms executed on slices.
+    /// </summary>
+    template<typename TContainer>
+    struct OffsetAlgorithmNodeSlice : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = OffsetAlgorithmNodeSlice<TContainer>;
+        using Container_t = TContainer;
+        using Size_t = typename TContainer::Size_t;
+
+    protected:
+        Size_t NodeOffset;
+
+    public:
+        OffsetAlgorithmNodeSlice(Size_t nodeOffset)
+            : NodeOffset(nodeOffset)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            if (T::Owner == ComponentOwner::Node)
+                component += NodeOffset;
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return true;
+        }
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return true;
+        }
+        bool ChunkIndex(Size_t& index)
+        {
+            return true;
+        }
+    };
+}
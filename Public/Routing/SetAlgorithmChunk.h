@@ -32,7 +32,7 @@ namespace NiT::Routing
         {
             auto& chunk = Container->GetChunk();
             const auto& chunkStructure = chunk.GetStructure();
-            auto index = chunkStructure.GetComponentTypeIndexInChunk(&typeid(T));
+            auto index = chunkStructure.template GetComponentTypeIndexInChunk<T>();
             if (index < 0)
                 return false;
             component = (T*)chunk.GetComponentData(index);
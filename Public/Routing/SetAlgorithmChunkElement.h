@@ -0,0 +1,54 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "SetAlgorithmChunk.h"
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Will set the required component pointers on an algorithm from a given chunk element of an array.
+    /// Component pointers are taken from the element directly so a range of elements can be
+    /// executed without offsetting from the first element of the array.
+    /// </summary>
+    /// <typeparam name="TContainer">Array container</typeparam>
+    template<typename TContainer>
+    struct SetAlgorithmChunkElement : public SetAlgorithmChunk<TContainer>
+    {
+    public:
+        using Base_t = SetAlgorithmChunk<TContainer>;
+        using Self_t = SetAlgorithmChunkElement<TContainer>;
+        using Container_t = TContainer;
+        using ChunkStructure_t = typename Container_t::ChunkStructure_t;
+        using Size_t = typename Container_t::Size_t;
+
+    protected:
+        Size_t ElementIndex;
+
+    public:
+        SetAlgorithmChunkElement(Container_t* container, const Size_t elementIndex)
+            : Base_t(container)
+            , ElementIndex(elementIndex)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            auto& chunkElement = (*this->Container)[ElementIndex];
+            const auto& chunkStructure = chunkElement.GetStructure();
+            auto index = chunkStructure.template GetComponentTypeIndexInChunk<T>();
+            if (index < 0)
+                return false;
+            component = (T*)chunkElement.GetComponentData(index);
+            return true;
+        }
+
+        bool ChunkIndex(Size_t& index)
+        {
+            index = ElementIndex;
+            return true;
+        }
+    };
+}
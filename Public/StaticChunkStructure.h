@@ -0,0 +1,456 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include <array>
+#include "ChunkStructure.h"
+#include "Containers.h"
+#include "AlgorithmRunner.h"
+#include "AlgorithmRunnerChunk.h"
+#include "Routing\SetAlgorithmChunk.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// A ChunkStructure whose component types are known at compile time.
+    /// The column order and the offset of each component's data in a single memory block are constexpr,
+    /// so containers of this structure find their component data without any lookup.
+    /// GetStructure() provides the equivalent runtime ChunkStructure to interoperate with dynamic containers, routers and pipelines.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    /// <typeparam name="...TComponents">Component types, each declaring its static Owner.</typeparam>
+    template<typename TSize, typename... TComponents>
+    struct StaticChunkStructureT
+    {
+    public:
+        using Self_t = StaticChunkStructureT<TSize, TComponents...>;
+        using Size_t = TSize;
+        using ChunkStructure_t = ChunkStructureT<Size_t>;
+        using ComponentType_t = typename ChunkStructure_t::ComponentType_t;
+        using Indices_t = std::array<Size_t, sizeof...(TComponents)>;
+
+        static constexpr Size_t ComponentCount = sizeof...(TComponents);
+        static_assert(ComponentCount > 0, "A StaticChunkStructure requires at least one component type.");
+
+        static constexpr Indices_t Sizes = { (Size_t)sizeof(TComponents)... };
+        static constexpr Indices_t Alignments = { (Size_t)alignof(TComponents)... };
+        static constexpr std::array<ComponentOwner, sizeof...(TComponents)> Owners = { TComponents::Owner... };
+
+    private:
+        static constexpr Indices_t ComputeBlockComponentIndex()
+        {
+            Indices_t order = {};
+            for (Size_t i = 0; i < ComponentCount; ++i)
+                order[i] = i;
+            // Stable insertion sort by decreasing alignment, no padding is then required between components.
+            for (Size_t i = 1; i < ComponentCount; ++i)
+                for (Size_t j = i; j > 0 && Alignments[order[j - 1]] < Alignments[order[j]]; --j)
+                {
+                    const Size_t tmp = order[j];
+                    order[j] = order[j - 1];
+                    order[j - 1] = tmp;
+                }
+            return order;
+        }
+
+        static constexpr Indices_t ComputeBlockOffset(const ComponentOwner owner)
+        {
+            Indices_t offsets = {};
+            Size_t offset = 0;
+            for (const Size_t index : ComputeBlockComponentIndex())
+            {
+                offsets[index] = offset;
+                if (Owners[index] == owner)
+                    offset += Sizes[index];
+            }
+            return offsets;
+        }
+
+        static constexpr Size_t ComputeBlockSize(const ComponentOwner owner)
+        {
+            Size_t size = 0;
+            for (Size_t i = 0; i < ComponentCount; ++i)
+                if (Owners[i] == owner)
+                    size += Sizes[i];
+            return size;
+        }
+
+        static constexpr Size_t ComputeBlockAlignment()
+        {
+            Size_t alignment = 1;
+            for (Size_t i = 0; i < ComponentCount; ++i)
+                alignment = std::max(alignment, Alignments[i]);
+            return alignment;
+        }
+
+    public:
+        /// <summary>
+        /// Component indices, in TComponents order, sorted by decreasing alignment.
+        /// Order in which the components' data are laid out in a single memory block.
+        /// </summary>
+        static constexpr Indices_t BlockComponentIndex = ComputeBlockComponentIndex();
+
+        /// <summary>
+        /// Per component index, bytes per node and bytes per chunk of all components laid out before it in a single memory block.
+        /// Node and chunk components' data are interleaved in BlockComponentIndex order, the same way as ChunkStructureT,
+        /// so each component's data offset BlockNodeOffset * nodeCapacity + BlockChunkOffset is a multiple of its alignment.
+        /// </summary>
+        static constexpr Indices_t BlockNodeOffset = ComputeBlockOffset(ComponentOwner::Node);
+        static constexpr Indices_t BlockChunkOffset = ComputeBlockOffset(ComponentOwner::Chunk);
+
+        static constexpr Size_t BlockNodeSize = ComputeBlockSize(ComponentOwner::Node);
+        static constexpr Size_t BlockChunkSize = ComputeBlockSize(ComponentOwner::Chunk);
+        static constexpr Size_t BlockAlignment = ComputeBlockAlignment();
+
+    private:
+        static constexpr bool ComputeIsBlockAligned()
+        {
+            for (Size_t i = 0; i < ComponentCount; ++i)
+                if (BlockNodeOffset[i] % Alignments[i] != 0 || BlockChunkOffset[i] % Alignments[i] != 0)
+                    return false;
+            return true;
+        }
+        static_assert(ComputeIsBlockAligned(), "Each component's data must be aligned in a single memory block for any node capacity.");
+
+    public:
+
+        /// <summary>
+        /// Get the index of a component type in TComponents, or -1 if not present.
+        /// </summary>
+        template<typename T>
+        static constexpr Size_t GetComponentIndex()
+        {
+            constexpr bool matches[] = { std::is_same_v<std::remove_cv_t<T>, TComponents>... };
+            for (Size_t i = 0; i < ComponentCount; ++i)
+                if (matches[i])
+                    return i;
+            return -1;
+        }
+
+        template<typename T>
+        static constexpr bool HasComponent() { return GetComponentIndex<T>() != -1; }
+
+        /// <summary>
+        /// Get the size in bytes of a single memory block large enough to hold all components' data for nodeCapacity nodes.
+        /// </summary>
+        static constexpr Size_t GetBlockSize(const Size_t nodeCapacity)
+        {
+            return BlockNodeSize * nodeCapacity + BlockChunkSize;
+        }
+
+        /// <summary>
+        /// Get a component's data in a single memory block sized for nodeCapacity nodes.
+        /// </summary>
+        template<typename T>
+        static T* GetBlockComponentData(void* const block, const Size_t nodeCapacity)
+        {
+            constexpr Size_t index = GetComponentIndex<T>();
+            static_assert(index != (Size_t)-1, "Component type is not part of the StaticChunkStructure.");
+            return (T*)((uint8*)block + BlockNodeOffset[index] * nodeCapacity + BlockChunkOffset[index]);
+        }
+
+        /// <summary>
+        /// Call function((T*)nullptr) for each component type T in TComponents order.
+        /// </summary>
+        template<typename TFunction>
+        static void ForEachComponentType(TFunction&& function)
+        {
+            (function((TComponents*)nullptr), ...);
+        }
+
+        /// <summary>
+        /// Get the runtime ChunkStructure with the same component types.
+        /// Created once per StaticChunkStructure and not interned in any ChunkStructureRegistry.
+        /// </summary>
+        static const ChunkStructure_t& GetStructure()
+        {
+            static const ComponentType_t componentTypes[] = { ComponentType_t((const TComponents*)nullptr)... };
+            static const ChunkStructure_t structure(std_vector<const ComponentType_t*>{ &componentTypes[GetComponentIndex<TComponents>()]... });
+            return structure;
+        }
+
+        /// <summary>
+        /// Get the index in GetStructure() of each component index in TComponents.
+        /// </summary>
+        static const Indices_t& GetStructureComponentIndex()
+        {
+            static const Indices_t indices = { GetStructure().template GetComponentTypeIndexInChunk<TComponents>()... };
+            return indices;
+        }
+    };
+
+    /// <summary>
+    /// A Bucket container of a StaticChunkStructure: one chunk and up to a fixed NodeCapacity of nodes in a single memory block it owns.
+    /// Component data are found at constexpr offsets in the block, an algorithm run on it is routed without any lookup.
+    /// Use GetChunkPointer() to access it as a dynamic ChunkPointer.
+    /// </summary>
+    template<typename TStaticChunkStructure>
+    struct StaticBucketT
+    {
+    public:
+        using Self_t = StaticBucketT<TStaticChunkStructure>;
+        using StaticChunkStructure_t = TStaticChunkStructure;
+        using ChunkStructure_t = typename StaticChunkStructure_t::ChunkStructure_t;
+        using Size_t = typename StaticChunkStructure_t::Size_t;
+        using ChunkPointer_t = ChunkPointerT<ChunkStructure_t>;
+
+    protected:
+        void* Block;
+        NodeCountT<Size_t> NodeCount;
+        NodeCapacityT<Size_t> NodeCapacity;
+
+        /// <summary>
+        /// Component data in GetStructure() order, used by dynamic routing and GetChunkPointer().
+        /// </summary>
+        void* ComponentDataArray[StaticChunkStructure_t::ComponentCount];
+
+    public:
+        StaticBucketT(const NodeCapacityT<Size_t> nodeCapacity)
+            : Block(nullptr)
+            , NodeCount(0)
+            , NodeCapacity(nodeCapacity)
+        {
+            Block = ni_alloc(StaticChunkStructure_t::GetBlockSize(NodeCapacity), StaticChunkStructure_t::BlockAlignment);
+            const auto& structureComponentIndex = StaticChunkStructure_t::GetStructureComponentIndex();
+            Size_t i = 0;
+            StaticChunkStructure_t::ForEachComponentType([&](auto* type)
+            {
+                using T = std::remove_pointer_t<decltype(type)>;
+                ComponentDataArray[structureComponentIndex[i++]] = (void*)GetComponentData<T>();
+            });
+            ConstructChunkComponents();
+        }
+#ifndef PNC_PROPS_STRICT
+        StaticBucketT(const Size_t nodeCapacity)
+            : StaticBucketT(PropNodeCapacityT<Size_t>(nodeCapacity))
+        {
+        }
+#endif
+
+        ~StaticBucketT()
+        {
+            if (!Block)
+                return;
+            Clear();
+            DestructChunkComponents();
+            ni_free_clean(Block, StaticChunkStructure_t::GetBlockSize(NodeCapacity), StaticChunkStructure_t::BlockAlignment);
+        }
+
+        // Non-copyable
+        StaticBucketT(const Self_t&) = delete;
+        Self_t& operator=(const Self_t&) = delete;
+
+    public:
+        bool IsNull()const { return Block == nullptr; }
+        NodeCountT<Size_t> GetNodeCount()const { return NodeCount; }
+        NodeCapacityT<Size_t> GetNodeCapacity()const { return NodeCapacity; }
+
+        const ChunkStructure_t& GetStructure()const { return StaticChunkStructure_t::GetStructure(); }
+        Self_t& GetChunk() { return *this; }
+        const Self_t& GetChunk()const { return *this; }
+
+        template<typename T>
+        T* GetComponentData() { return StaticChunkStructure_t::template GetBlockComponentData<T>(Block, NodeCapacity); }
+        template<typename T>
+        const T* GetComponentData()const { return StaticChunkStructure_t::template GetBlockComponentData<const T>(Block, NodeCapacity); }
+
+        void* GetComponentData(const Size_t componentTypeIndexInChunk) { return ComponentDataArray[componentTypeIndexInChunk]; }
+        const void* GetComponentData(const Size_t componentTypeIndexInChunk)const { return ComponentDataArray[componentTypeIndexInChunk]; }
+
+        /// <summary>
+        /// Get a ChunkPointer to this bucket's data, usable with any dynamic algorithm runner or router.
+        /// </summary>
+        ChunkPointer_t GetChunkPointer()
+        {
+            return ChunkPointer_t(&GetStructure(), NodeCount, PropComponentDataArray(ComponentDataArray));
+        }
+
+        /// <summary>
+        /// Add multiple sequential default constructed nodes at index NodeCount and return the index of the first node added.
+        /// If NodeCount + count > NodeCapacity, return -1 without adding any new nodes.
+        /// </summary>
+        Size_t AddNodes(const Size_t count)
+        {
+            const Size_t firstIndex = NodeCount;
+            if (firstIndex + count > NodeCapacity)
+                return -1;
+            StaticChunkStructure_t::ForEachComponentType([&](auto* type)
+            {
+                ConstructNodes<std::remove_pointer_t<decltype(type)>>(firstIndex, count);
+            });
+            NodeCount += count;
+            return firstIndex;
+        }
+
+        Size_t AddNode() { return AddNodes(1); }
+
+        /// <summary>
+        /// Remove a range of nodes and close the gap by moving the trailing nodes in
+        /// the gap, which will break the previous ordering of nodes.
+        /// </summary>
+        void RemoveNode(const Size_t firstNodeIndex, const Size_t nodeCount = 1)
+        {
+            ni_assert(firstNodeIndex >= 0);
+            ni_assert(nodeCount >= 0);
+            ni_assert(firstNodeIndex + nodeCount <= NodeCount);
+            const Size_t movingFirstNodeIndex = std::max<Size_t>(firstNodeIndex + nodeCount, NodeCount - nodeCount);
+            const Size_t movingNodeCount = NodeCount - movingFirstNodeIndex;
+            StaticChunkStructure_t::ForEachComponentType([&](auto* type)
+            {
+                RemoveNodes<std::remove_pointer_t<decltype(type)>>(firstNodeIndex, nodeCount, movingFirstNodeIndex, movingNodeCount);
+            });
+            NodeCount -= nodeCount;
+        }
+
+        /// <summary>
+        /// Destruct all nodes and set NodeCount to 0.
+        /// ChunkComponents are NOT destructed.
+        /// </summary>
+        void Clear()
+        {
+            StaticChunkStructure_t::ForEachComponentType([&](auto* type)
+            {
+                DestructNodes<std::remove_pointer_t<decltype(type)>>(0, NodeCount);
+            });
+            NodeCount = NodeCountT<Size_t>::V_0();
+        }
+
+    private:
+        template<typename T>
+        static constexpr bool IsNode() { return T::Owner == ComponentOwner::Node; }
+
+        template<typename T>
+        void ConstructNodes(const Size_t firstIndex, const Size_t count)
+        {
+            if constexpr (IsNode<T>())
+            {
+                T* const data = GetComponentData<T>();
+                for (Size_t i = firstIndex; i < firstIndex + count; ++i)
+                    new (data + i) T();
+            }
+        }
+
+        template<typename T>
+        void DestructNodes(const Size_t firstIndex, const Size_t count)
+        {
+            if constexpr (IsNode<T>() && !std::is_trivially_destructible_v<T>)
+            {
+                T* const data = GetComponentData<T>();
+                for (Size_t i = firstIndex; i < firstIndex + count; ++i)
+                    data[i].~T();
+            }
+        }
+
+        template<typename T>
+        void RemoveNodes(const Size_t firstIndex, const Size_t count, const Size_t movingFirstIndex, const Size_t movingCount)
+        {
+            if constexpr (IsNode<T>())
+            {
+                DestructNodes<T>(firstIndex, count);
+                T* const data = GetComponentData<T>();
+                if constexpr (IsTriviallyRelocatable<T>::value)
+                {
+                    if (movingCount > 0)
+                        std::memcpy(data + firstIndex, data + movingFirstIndex, sizeof(T) * movingCount);
+                }
+                else
+                {
+                    for (Size_t i = 0; i < movingCount; ++i)
+                    {
+                        new (data + firstIndex + i) T(std::move(data[movingFirstIndex + i]));
+                        data[movingFirstIndex + i].~T();
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void ConstructChunkComponent()
+        {
+            if constexpr (!IsNode<T>())
+                new (GetComponentData<T>()) T();
+        }
+
+        template<typename T>
+        void DestructChunkComponent()
+        {
+            if constexpr (!IsNode<T>())
+                GetComponentData<T>()->~T();
+        }
+
+        void ConstructChunkComponents()
+        {
+            StaticChunkStructure_t::ForEachComponentType([&](auto* type) { ConstructChunkComponent<std::remove_pointer_t<decltype(type)>>(); });
+        }
+        void DestructChunkComponents()
+        {
+            StaticChunkStructure_t::ForEachComponentType([&](auto* type) { DestructChunkComponent<std::remove_pointer_t<decltype(type)>>(); });
+        }
+    };
+
+    template<typename TA, typename TStaticChunkStructure>
+    struct AlgorithmRunner<TA, StaticBucketT<TStaticChunkStructure>> : public AlgorithmRunnerChunk<StaticBucketT<TStaticChunkStructure>> {};
+}
+
+namespace NiT::Routing
+{
+    /// <summary>
+    /// Will set the required component pointers on an algorithm from a StaticBucket.
+    /// Component pointers are taken at constexpr offsets, no component lookup is done.
+    /// </summary>
+    template<typename TStaticChunkStructure>
+    struct SetAlgorithmChunk<StaticBucketT<TStaticChunkStructure>> : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Container_t = StaticBucketT<TStaticChunkStructure>;
+        using Self_t = SetAlgorithmChunk<Container_t>;
+        using ChunkStructure_t = typename Container_t::ChunkStructure_t;
+        using Size_t = typename Container_t::Size_t;
+
+    protected:
+        Container_t* Container;
+
+    public:
+        SetAlgorithmChunk(Container_t* container)
+            :Container(container)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            if constexpr (TStaticChunkStructure::template HasComponent<T>())
+            {
+                component = Container->template GetComponentData<T>();
+                return true;
+            }
+            else
+                return false;
+        }
+
+        bool ChunkIndex(Size_t& index)
+        {
+            index = 0;
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            return false;
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return false;
+        }
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return false;
+        }
+    };
+}
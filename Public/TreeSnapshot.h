@@ -0,0 +1,114 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace NiT
+{
+    /// <summary>
+    /// Contiguous depth-first pre-order array of all containers of a tree under a root container.
+    /// Each container's subtree is the range [index, index + GetSubtreeSize(index)), so walking the tree,
+    /// skipping a subtree or finding a parent are index arithmetic instead of following sibling rings.
+    /// The snapshot is stale as soon as the tree version of the root's tree changes, see IsUpToDate.
+    /// </summary>
+    /// <typeparam name="TTreePointer">DTreePointer container type of the tree, ex.: KTreePointerT</typeparam>
+    template<typename TTreePointer>
+    struct TreeSnapshotT
+    {
+    public:
+        using Self_t = TreeSnapshotT<TTreePointer>;
+        using TreePointer_t = TTreePointer;
+        using Size_t = typename TreePointer_t::Size_t;
+
+    protected:
+        std_vector<TreePointer_t*> Containers;
+
+        /// <summary>
+        /// Index of each container's parent, -1 for the root.
+        /// </summary>
+        std_vector<Size_t> ParentIndices;
+
+        /// <summary>
+        /// Number of containers in each container's subtree, including itself.
+        /// </summary>
+        std_vector<Size_t> SubtreeSizes;
+
+        const TreePointer_t* Root = nullptr;
+        uint32 TreeVersion = 0;
+
+    public:
+        bool IsUpToDate(const TreePointer_t& root)const
+        {
+            return Root == &root && TreeVersion == root.GetTreeVersion();
+        }
+
+        /// <summary>
+        /// Rebuild the snapshot if the tree was restructured or if the root is different since the last build.
+        /// </summary>
+        void Update(TreePointer_t& root)
+        {
+            if (!IsUpToDate(root))
+                Build(root);
+        }
+
+        void Build(TreePointer_t& root)
+        {
+            TreeVersion = root.GetTreeVersion();
+            Root = &root;
+            Containers.clear();
+            ParentIndices.clear();
+            SubtreeSizes.clear();
+
+            std_vector<std::pair<TreePointer_t*, Size_t>> stack;
+            stack.emplace_back(&root, -1);
+            while (!stack.empty())
+            {
+                const auto [container, parentIndex] = stack.back();
+                stack.pop_back();
+                const Size_t index = (Size_t)Containers.size();
+                Containers.push_back(container);
+                ParentIndices.push_back(parentIndex);
+                SubtreeSizes.push_back(1);
+
+                // Push children last to first so the first child is visited next
+                TreePointer_t* const firstChild = container->GetFirstChildChunk();
+                if (firstChild == nullptr)
+                    continue;
+                for (TreePointer_t* child = firstChild->GetPreviousSiblingChunk();; child = child->GetPreviousSiblingChunk())
+                {
+                    stack.emplace_back(child, index);
+                    if (child == firstChild)
+                        break;
+                }
+            }
+
+            // Parents come before their children, accumulate subtree sizes from the last container up.
+            for (Size_t i = (Size_t)Containers.size() - 1; i > 0; --i)
+                SubtreeSizes[ParentIndices[i]] += SubtreeSizes[i];
+        }
+
+        Size_t GetCount()const { return (Size_t)Containers.size(); }
+        TreePointer_t* GetContainer(const Size_t index)const { return Containers[index]; }
+        TreePointer_t* const* GetContainers()const { return Containers.data(); }
+        Size_t GetParentIndex(const Size_t index)const { return ParentIndices[index]; }
+        Size_t GetSubtreeSize(const Size_t index)const { return SubtreeSizes[index]; }
+
+        /// <summary>
+        /// Index of the container following the subtree of a container, which is its next sibling
+        /// or the next sibling of its closest ancestor having one, or GetCount() at the end.
+        /// </summary>
+        Size_t GetSubtreeEndIndex(const Size_t index)const { return index + SubtreeSizes[index]; }
+
+        /// <summary>
+        /// Depth of a container below the root, 0 for the root.
+        /// </summary>
+        Size_t GetDepth(Size_t index)const
+        {
+            Size_t depth = 0;
+            for (index = ParentIndices[index]; index >= 0; index = ParentIndices[index])
+                ++depth;
+            return depth;
+        }
+    };
+}
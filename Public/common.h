@@ -14,11 +14,48 @@
 #include <unordered_set>
 #include <vector>
 #include <algorithm> 
+#include <atomic>
+#include <mutex>
+#include <bit>
 #include "CoreMinimal.h"
 
 #ifdef WITH_EDITOR
 #   define NI_ASSERT_THROW
 #   define NI_MEMORYTRACKER
+// Validate pointers with ni_assert_owns. NI_MEMORYTRACKER can be defined alone to only count memory.
+#   define NI_MEMORYTRACKER_OWNERSHIP
+#endif
+
+// Allocate all components' data of a chunk in a single memory block instead of one allocation per component type
+#ifndef NI_MEMORY_NO_SINGLE_BLOCK
+#   define NI_MEMORY_SINGLE_BLOCK
+#endif
+
+// Count the memory of components' data per ChunkStructure and ComponentType, also in shipping builds.
+// Only relaxed atomic counters, independent from the MemoryTracker.
+#ifndef NI_MEMORY_NO_STATS
+#   define NI_MEMORY_STATS
+#endif
+
+// Maximum number of components a single algorithm can require when routed with an AlgorithmCacheRouter.
+#ifndef NI_ROUTE_CAPACITY
+#   define NI_ROUTE_CAPACITY 16
+#endif
+
+// Number of component type ids held in the fixed-width bits of a ComponentMask. Must be a multiple of 64.
+// Ids above it still work but fall back to a sorted overflow list.
+#ifndef NI_COMPONENT_MASK_BITS
+#   define NI_COMPONENT_MASK_BITS 256
+#endif
+
+// Number of component columns per chunk tracked by CoChangeVersion. Columns above it are always considered changed.
+#ifndef NI_CHANGE_VERSION_CAPACITY
+#   define NI_CHANGE_VERSION_CAPACITY 32
+#endif
+
+// Number of handles ahead NodeHandleTable::ResolveBatch prefetches the table slot of, and NodeHandleTable::ForEachResolved the node's component of.
+#ifndef NI_NODE_HANDLE_PREFETCH_DISTANCE
+#   define NI_NODE_HANDLE_PREFETCH_DISTANCE 8
 #endif
 
 #define NI_STRINGIFY(x) #x
@@ -41,6 +78,7 @@
 #   define ni_todo(msg)
 #endif
 #define NI_FORCEINLINE __forceinline 
+#define ni_prefetch(ptr) FPlatformMisc::Prefetch(ptr)
 
 #define NI_ASSERT_LOC(condition) "Condition: " #condition "\n" "Location: (" __FILE__ ":" NI_TO_STRING(__LINE__) ")"
 